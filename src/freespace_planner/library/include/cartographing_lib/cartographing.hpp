@@ -18,23 +18,32 @@ namespace py = pybind11;
 class Cartographing
 {
 private:
-  inline static size_t patch_dim_ = 0;
-  inline static Vec2DFlat<uint8_t> patch_arr_;
-  inline static Vec2DFlat<uint8_t> temp_patch_;
-  inline static Vec2DFlat<uint8_t> local_map_;
+  // Receives the cartographed patch
+  CollisionChecker& collision_checker_;
+  const grid_tf& grid_tf_;
+
+  size_t patch_dim_ = 0;
+  Vec2DFlat<uint8_t> patch_arr_;
+  Vec2DFlat<uint8_t> temp_patch_;
+  Vec2DFlat<uint8_t> local_map_;
 
 public:
-  static void resetPatch(size_t patch_dim);
+  Cartographing(CollisionChecker& collision_checker, const grid_tf& transforms)
+    : collision_checker_(collision_checker), grid_tf_(transforms)
+  {
+  }
+
+  void resetPatch(size_t patch_dim);
 
-  static void cartograph(const py::array_t<uint8_t>& local_map, const Point<int>& origin, int dim);
+  void cartograph(const py::array_t<uint8_t>& local_map, const Point<int>& origin, int dim);
 
-  static void cartograph(const Vec2DFlat<uint8_t>& local_map_data, const Point<int>& origin, int dim);
+  void cartograph(const Vec2DFlat<uint8_t>& local_map_data, const Point<int>& origin, int dim);
 
-  static void passLocalMap(const Point<int>& origin, int dim);
+  void passLocalMap(const Point<int>& origin, int dim);
 
-  static void loadPrevPatch(const Point<double>& prev_origin_utm, const Point<double>& origin_utm);
+  void loadPrevPatch(const Point<double>& prev_origin_utm, const Point<double>& origin_utm);
 
-  static py::array_t<uint8_t> getMap();
+  py::array_t<uint8_t> getMap() const;
 };
 
 #endif  // CARTOGRAPHING_HPP
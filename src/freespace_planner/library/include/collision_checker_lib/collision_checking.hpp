@@ -6,18 +6,22 @@
 
 #include <cmath>
 #include <vector>
+#include <span>
 #include <iostream>
 #include <execution>  // for parallel execution of std::transform...
 #include "opencv2/imgproc.hpp"
 #include "opencv2/highgui.hpp"
+#ifdef USE_CUDA
 #include "opencv2/cudafilters.hpp"
 #include "opencv2/cudaimgproc.hpp"
+#endif
 
 #include "yaml-cpp/yaml.h"
 
 #include "util_lib/util1.hpp"
 #include "util_lib/data_structures1.hpp"
 #include "util_lib/transforms.hpp"
+#include "util_lib/thread_pool.hpp"
 
 #include "vehicle.hpp"
 
@@ -31,6 +35,7 @@ namespace py = pybind11;
  * are used to represent the ego vehicle
  * Here, the sparse collision checking of the following paper of Ziegler et. al is used:
  * https://ieeexplore.ieee.org/stamp/stamp.jsp?arnumber=5547976
+ * Every planner context has its own checker with its own patches.
  */
 class CollisionChecker
 {
@@ -46,79 +51,121 @@ public:
   };
 
 private:
-  inline static size_t patch_dim_;
-  inline static uint8_t min_thresh_;
-  inline static uint8_t max_thresh_;
-  inline static unsigned int yaw_res_coll_;
-  inline static double yaw_res_coll_rad_;
-  inline static unsigned int nb_disc_yaws_;
-  inline static unsigned int nb_disks_;
-  inline static bool double_disk_rows_;
-  inline static double len_per_disk_;
-
-  inline static int disk_diameter_c_;
-  inline static double safety_distance_m_;
-  inline static cv::Mat dil_kernel_;
-  inline static cv::Ptr<cv::cuda::Filter> dilateFilter_;
-  inline static double search_dist_;
-  inline static double max_patch_ins_dist_;
+  enum DilationBackend
+  {
+    DILATION_CPU,
+    DILATION_CUDA
+  };
+
+  // Vehicle whose disks are checked and transforms of the planning patch, owned by the planner context
+  const Vehicle& vehicle_;
+  grid_tf& grid_tf_;
+
+  size_t patch_dim_ = 0;
+  uint8_t min_thresh_ = 0;
+  uint8_t max_thresh_ = 0;
+  unsigned int yaw_res_coll_ = 0;
+  double yaw_res_coll_rad_ = 0;
+  unsigned int nb_disc_yaws_ = 0;
+  unsigned int nb_disks_ = 0;
+  bool double_disk_rows_ = false;
+  double len_per_disk_ = 0;
+
+  int disk_diameter_c_ = 0;
+  double safety_distance_m_ = 0;
+  cv::Mat dil_kernel_;
+#ifdef USE_CUDA
+  cv::Ptr<cv::cuda::Filter> dilateFilter_;
+#endif
+  DilationBackend dilation_backend_ = DILATION_CPU;
+  // Half width of every row of the dilation kernel, -1 for empty rows
+  std::vector<int> kernel_half_widths_;
+  // Horizontal distances to the next occupied and the next not free cell, capped at 255
+  std::vector<uint8_t> occ_dist_;
+  std::vector<uint8_t> unknown_dist_;
+  ThreadPool dilation_pool_;
+  double search_dist_ = 0;
+  double max_patch_ins_dist_ = 0;
 
   // array of disk centers
-  inline static Vec2DFlat<Point<int>> disk_centers_;
+  Vec2DFlat<Point<int>> disk_centers_;
+  // incremented whenever the disks change, precomputed footprints have to be rebuilt then
+  size_t disks_version_ = 0;
 
 public:
-  inline static double gm_res_;
-  inline static int disk_r_c_;
+  double gm_res_ = 0;
+  int disk_r_c_ = 0;
 
-  inline static Vec2DFlat<uint8_t> patch_arr_;
-  inline static Vec2DFlat<uint8_t> patch_safety_arr_;
+  Vec2DFlat<uint8_t> patch_arr_;
+  Vec2DFlat<uint8_t> patch_safety_arr_;
 
-  inline static size_t getPatchDim()
+  CollisionChecker(const Vehicle& vehicle, grid_tf& transforms) : vehicle_(vehicle), grid_tf_(transforms)
+  {
+  }
+
+  size_t getPatchDim() const
   {
     return patch_dim_;
   }
 
-  static void initialize(size_t patch_dim, const std::string& path2config);
+  void initialize(size_t patch_dim, const std::string& path2config);
 
-  static void calculateDisks();
+  void calculateDisks();
 
   static double getDiskRadius(double length, double width, unsigned int nb_disks);
 
   static std::vector<double> getDiskPositions(double radius, unsigned int nb_disks, double width, double lb);
 
-  static std::vector<Point<int>> returnDiskPositions(double yaw);
+  std::vector<Point<int>> returnDiskPositions(double yaw) const;
+
+  size_t getDisksVersion() const
+  {
+    return disks_version_;
+  }
+
+  void resetPatch(size_t patch_dim);
+
+  void processSafetyPatch();
+
+  void processSafetyPatchCpu();
+
+#ifdef USE_CUDA
+  void processSafetyPatchCuda();
+#endif
 
-  static void resetPatch(size_t patch_dim);
+  void insertMinipatches(const std::map<std::pair<int, int>, Minipatch>& minipatches,
+                         const Point<double>& ego_utm,
+                         bool only_nearest,
+                         bool only_new);
 
-  static void processSafetyPatch();
+  void passLocalMap(const py::array_t<uint8_t>& local_map, const Point<int>& origin, int dim);
 
-  static void insertMinipatches(const std::map<std::pair<int, int>, Minipatch>& minipatches,
-                                const Point<double>& ego_utm,
-                                bool only_nearest,
-                                bool only_new);
+  void passLocalMap(const Vec2DFlat<uint8_t>& local_map, const Point<int>& origin, int dim);
 
-  static void passLocalMap(const py::array_t<uint8_t>& local_map, const Point<int>& origin, int dim);
+  void passLocalMapData(const unsigned char* local_map, const Point<int>& origin, int dim);
 
-  static void passLocalMap(const Vec2DFlat<uint8_t>& local_map, const Point<int>& origin, int dim);
+  int getYawIdx(double yaw) const;
 
-  static void passLocalMapData(const unsigned char* local_map, const Point<int>& origin, int dim);
+  bool checkGrid(const Pose<int>& pose) const;
 
-  static int getYawIdx(double yaw);
+  bool checkGridVariant(const Pose<int>& pose) const;
 
-  static bool checkGrid(const Pose<int>& pose);
+  bool checkPose(const Pose<double>& pose) const;
 
-  static bool checkGridVariant(const Pose<int>& pose);
+  bool checkPoseVariant(const Pose<double>& pose) const;
 
-  static bool checkPose(const Pose<double>& pose);
+  int getPathCollisionIndex(const std::vector<double>& x_list,
+                            const std::vector<double>& y_list,
+                            const std::vector<double>& yaw_list) const;
 
-  static bool checkPoseVariant(const Pose<double>& pose);
+  bool checkPathCollision(const std::vector<double>& x_list,
+                          const std::vector<double>& y_list,
+                          const std::vector<double>& yaw_list) const;
 
-  static int getPathCollisionIndex(const std::vector<double>& x_list,
-                                   const std::vector<double>& y_list,
-                                   const std::vector<double>& yaw_list);
+  std::vector<Point<int>> getSweptCells(const std::vector<double>& x_list,
+                                        const std::vector<double>& y_list,
+                                        const std::vector<double>& yaw_list) const;
 
-  static bool checkPathCollision(const std::vector<double>& x_list,
-                                 const std::vector<double>& y_list,
-                                 const std::vector<double>& yaw_list);
+  bool checkSweptCells(const Point<int>& origin, std::span<const Point<int>> cells) const;
 };
 #endif  // PLANNING_BINDINGS_COLLISION_CHECKING_HPP
@@ -18,32 +18,32 @@
 class Vehicle
 {
 public:
-  inline static Pose<double> pose_utm_;
-  inline static bool is_ushift_;
-  inline static double max_steer_;
-  inline static double max_curvature_;
-  inline static double w_b_;
-  inline static double lf_;
-  inline static double lb_;
-  inline static double length_;
-  inline static double width_;
-  inline static double geo_center_;
-  inline static Point<double> f_r_corner_;
-  inline static Point<double> f_l_corner_;
-  inline static Point<double> r_r_corner_;
-  inline static Point<double> r_l_corner_;
-  inline static std::vector<Point<double>> vehicle_vertices_;
-
-  static void setPose(const Pose<double>& pose);
-
-  static void initialize(double max_steer, double w_b, double l_f, double l_b, double width, bool is_ushift);
-
-  static std::vector<Point<double>> getVehicleVertices();
-
-  static void move(Pose<double>& pose, double distance, double steer);
-
-  static MotionPrimitive
-  move_car_some_steps(const Pose<double>& pose, double arc_l, double motion_res, int direction, double steer);
+  Pose<double> pose_utm_;
+  bool is_ushift_ = false;
+  double max_steer_ = 0;
+  double max_curvature_ = 0;
+  double w_b_ = 0;
+  double lf_ = 0;
+  double lb_ = 0;
+  double length_ = 0;
+  double width_ = 0;
+  double geo_center_ = 0;
+  Point<double> f_r_corner_;
+  Point<double> f_l_corner_;
+  Point<double> r_r_corner_;
+  Point<double> r_l_corner_;
+  std::vector<Point<double>> vehicle_vertices_;
+
+  void setPose(const Pose<double>& pose);
+
+  void initialize(double max_steer, double w_b, double l_f, double l_b, double width, bool is_ushift);
+
+  std::vector<Point<double>> getVehicleVertices() const;
+
+  void move(Pose<double>& pose, double distance, double steer) const;
+
+  MotionPrimitive
+  move_car_some_steps(const Pose<double>& pose, double arc_l, double motion_res, int direction, double steer) const;
 
   static MotionPrimitive turn_on_rear_axis(const Pose<double>& pose, double delta_angle, double yaw_res_coll);
 };
@@ -12,6 +12,7 @@
 #include <cstdio>
 #include <iostream>
 #include <cudnn.h>
+#include <mutex>
 #include <vector>
 
 #define CUDNN_DTYPE CUDNN_DATA_INT8
@@ -26,6 +27,10 @@
     }                                                                                                                  \
   }
 
+/**
+ * cuDNN max pooling. The handle and the device buffers exist once per process and are shared by all planner contexts,
+ * so the calls are serialized
+ */
 class Pooling
 {
 public:
@@ -33,6 +38,8 @@ public:
 
   static void execute(const uint8_t* image_pointer, uint8_t* result, int in_dim, int out_dim);
 
+  static void reserve(int in_dim, int out_dim);
+
   inline static cudnnHandle_t cudnn_;
   inline static cudnnTensorDescriptor_t in_desc_;
   inline static cudnnTensorDescriptor_t out_desc_;
@@ -40,6 +47,14 @@ public:
 
   inline static float alpha_ = 1.0F;
   inline static float beta_ = 0.0F;
+
+  // Device buffers and tensor descriptors, reused while the dimensions do not change
+  inline static int in_dim_ = 0;
+  inline static int out_dim_ = 0;
+  inline static uint8_t* in_data_ = nullptr;
+  inline static uint8_t* out_data_ = nullptr;
+
+  inline static std::mutex mutex_;
 };
 
 #endif  // MAX_POOL_CUDA_MAX_POOL_CUH
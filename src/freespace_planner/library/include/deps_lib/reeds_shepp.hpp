@@ -43,6 +43,7 @@
 #include <cmath>
 #include <array>
 #include <vector>
+#include <span>
 #include <cassert>
 
 #include <util_lib/data_structures1.hpp>
@@ -89,10 +90,10 @@ public:
 
     /** Path segment types */
     std::array<ReedsSheppPathSegmentType, 5> type_;
-    /** Path segment lengths */
-    std::array<double, 5> length_;  // TODO (Schumann) Why on earth is this false. The value is corrected later
+    /** Path segment lengths in units of the turning radius, lengths holds them in meters */
+    std::array<double, 5> length_;
 
-    /** Total length */
+    /** Total length in units of the turning radius */
     double totalLength_;
     double radi;
     std::vector<char> ctypes;
@@ -113,13 +114,23 @@ public:
   void
   type(const Pose<double>& q_0, const Pose<double>& q_1, ReedsSheppPathTypeCallback callback, void* user_data) const;
 
-  ReedsSheppPath sample(const Pose<double>& q_0, const Pose<double>& q_1, double step_size);
+  void distances(std::span<const Pose<double>> starts, const Pose<double>& goal, std::span<double> dists) const;
+
+  [[nodiscard]] ReedsSheppPath shortestPath(const Pose<double>& q_0, const Pose<double>& q_1) const;
+
+  [[nodiscard]] ReedsSheppPath sample(const Pose<double>& q_0, const Pose<double>& q_1, double step_size) const;
+
+  void sample(const Pose<double>& q_0, const Pose<double>& q_1, double step_size, ReedsSheppPath& path) const;
+
+  [[nodiscard]] size_t nbSamples(const ReedsSheppPath& path, double step_size) const;
+
+  Pose<double> interpolate(const Pose<double>& q_0, const ReedsSheppPath& path, double dist, int& direction) const;
 
   /** \brief Return the shortest Reeds-Shepp path from SE(2) state state1 to SE(2) state state2 */
   [[nodiscard]] ReedsSheppPath reedsShepp(const Pose<double>& q_0, const Pose<double>& q_1) const;
 
 protected:
-  void interpolate(const Pose<double>& q_0, ReedsSheppPath& path, double seg) const;
+  void toLocal(const Pose<double>& q_0, const Pose<double>& q_1, double& x, double& y, double& phi) const;
 
   /** \brief Turning radius */
   double rho_;
@@ -10,7 +10,11 @@
 #include <unordered_map>
 #include "opencv2/imgproc.hpp"
 
+#ifdef USE_CUDA
 #include "cuda_lib/max_pool.hpp"
+#endif
+#include "util_lib/max_pool_cpu.hpp"
+#include "util_lib/distance_transform.hpp"
 
 #include "collision_checker_lib/collision_checking.hpp"
 
@@ -29,11 +33,29 @@
 namespace py = pybind11;
 
 /**
- * Main class, that organizes the 2D search
+ * Main class, that organizes the 2D search and the Voronoi potential field of one planner context
  */
 class AStar
 {
 private:
+  enum HeuristicQueueType
+  {
+    BINARY_HEAP,
+    BUCKET_QUEUE
+  };
+
+  enum PoolingBackend
+  {
+    POOLING_CPU,
+    POOLING_CUDA
+  };
+
+  enum VoronoiBackend
+  {
+    VORONOI_FORTUNE,
+    VORONOI_EDT
+  };
+
   inline static constexpr uint8_t NB_GRID_MOTIONS = 8;
   inline static constexpr size_t NUM_RESULTS = 1;
   inline static constexpr uint8_t MAP_DIM = 2;
@@ -47,113 +69,218 @@ private:
   // Dimension set at compile-time
   using my_kd_tree_t = KDTreeVectorOfVectorsAdaptor<vector_of_arrays, double, MAP_DIM, nanoflann::metric_L2_Simple>;
 
-  inline static Point<double> patch_origin_utm_;
-  inline static Point<int> patch_origin_astar_;
-  inline static vector_of_arrays obs_samples_;
-  inline static vector_of_arrays vor_samples_;
-
-  inline static double unknown_cost_w_;
-  inline static double astar_res_;
-  inline static size_t patch_dim_;
-  inline static double gm_res_;
-  inline static bool heuristic_early_exit_;
-  inline static unsigned int max_extra_nodes_;
-  inline static size_t obs_size_ = 1000;
-  inline static size_t vor_size_ = 1000;
-
-  inline static double motion_res_min_;
-  inline static double motion_res_max_;
-  inline static double dist_val_min_;
-  inline static double dist_val_max_;
-
-  inline static std::array<std::array<double, MAP_DIM>, VOR_DIM * VOR_DIM> vor_coords_;
-  inline static std::array<std::array<double, MAP_DIM>, VOR_DIM_SAMPLING * VOR_DIM_SAMPLING> vor_coords_sampling_;
+  // Source of the grid and the transforms, owned by the planner context
+  const CollisionChecker& collision_checker_;
+  const grid_tf& grid_tf_;
+
+  PoolingCpu pooling_cpu_;
+  DistanceTransform distance_transform_;
+
+  Point<double> patch_origin_utm_;
+  Point<int> patch_origin_astar_;
+  vector_of_arrays obs_samples_;
+  vector_of_arrays vor_samples_;
+
+  double unknown_cost_w_ = 0;
+  double astar_res_ = 0;
+  size_t patch_dim_ = 0;
+  double gm_res_ = 0;
+  bool heuristic_early_exit_ = false;
+  HeuristicQueueType heuristic_queue_type_ = BINARY_HEAP;
+  // The bucket queue does not order the nodes of one bucket, the heuristic is only approximate with it
+  double bucket_width_ = 0;
+  PoolingBackend pooling_backend_ = POOLING_CPU;
+  VoronoiBackend voronoi_backend_ = VORONOI_FORTUNE;
+  unsigned int max_extra_nodes_ = 0;
+  size_t obs_size_ = 1000;
+  size_t vor_size_ = 1000;
+
+  double motion_res_min_ = 0;
+  double motion_res_max_ = 0;
+  double dist_val_min_ = 0;
+  double dist_val_max_ = 0;
+
+  vector_of_arrays vor_coords_;
+  vector_of_arrays vor_coords_sampling_;
+
+  // Feature transforms of the obstacles and the Voronoi edges on the full patch or a padded tile
+  inline static constexpr uint8_t VOR_CACHE_UNSEEN = 255;
+  inline static constexpr int VOR_TILE_PAD_FACTOR = 3;
+  int vor_tile_dim_ = 0;
+  std::vector<uint8_t> vor_tile_dirty_;
+  std::array<double, 5> vor_cache_params_ = {};
+  std::vector<uint8_t> edt_sites_;
+  std::vector<double> obs_dist_sqr_;
+  std::vector<int> obs_nearest_;
+  std::vector<double> vor_dist_sqr_;
+  std::vector<int> vor_nearest_;
 
   inline static const std::array<Point<int>, NB_GRID_MOTIONS> motion_ = {
     { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 }, { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 } }
   };
-  inline static std::array<double, NB_GRID_MOTIONS> movement_distances_;
+  std::array<double, NB_GRID_MOTIONS> movement_distances_;
+
+  // Frontiers of the distance heuristic
+  IndexedPriorityQueue<size_t, double> frontier_;
+  BucketQueue<size_t, double> bucket_frontier_;
+
+  // Heuristic handed out to python
+  RecordBuffer<NodeDiscRecord> heuristic_records_;
+
+  // Inputs of the last guidance heuristic, the next one is repaired where they changed
+  inline static constexpr double MAX_INCREMENTAL_CHANGE_RATIO = 0.1;
+  bool heuristic_incremental_ = false;
+  bool guidance_valid_ = false;
+  Point<int> guidance_goal_;
+  std::vector<uint8_t> guidance_grid_;
+  std::vector<double> guidance_prox_;
+  std::vector<double> guidance_movement_;
 
 public:
+  /**
+   * Buffers of a distance heuristic that is calculated besides the ones of the class, e.g. by parallel searches
+   */
+  struct HeuristicBuffers
+  {
+    NodeDiscGrid node_grid;
+    IndexedPriorityQueue<size_t, double> frontier;
+    BucketQueue<size_t, double> bucket_frontier;
+    std::vector<std::pair<double, NodeDisc>> nodes_near_goal;
+  };
+
   // voronoi field
-  inline static double alpha_;
-  inline static double do_max_;
-  inline static double do_min_;
+  double alpha_ = 0;
+  double do_max_ = 0;
+  double do_min_ = 0;
 
-  inline static double astar_movement_cost_;
-  inline static double astar_prox_cost_;
-  inline static double astar_lane_movement_cost_;
+  double astar_movement_cost_ = 0;
+  double astar_prox_cost_ = 0;
+  double astar_lane_movement_cost_ = 0;
 
-  inline static int astar_dim_;
-  inline static std::string path2config_;
+  int astar_dim_ = 0;
+  std::string path2config_;
 
-  inline static std::unordered_map<size_t, NodeDisc> closed_set_path_;
-  inline static std::unordered_map<size_t, NodeDisc> closed_set_guidance_;
+  // Heuristics as dense grids, only closed nodes are part of them
+  NodeDiscGrid closed_set_path_;
+  NodeDiscGrid closed_set_guidance_;
 
-  inline static std::vector<std::pair<double, NodeDisc>> nodes_near_goal_;
+  std::vector<std::pair<double, NodeDisc>> nodes_near_goal_;
 
-  inline static Vec2DFlat<uint8_t> astar_grid_;
-  inline static Vec2DFlat<double> movement_cost_map_;
+  Vec2DFlat<uint8_t> astar_grid_;
+  Vec2DFlat<double> movement_cost_map_;
 
   // voronoi dependant arrays are copied on new patch creation
-  inline static Vec2DFlat<double> h_prox_arr_;
-  inline static Vec2DFlat<double> temp_h_prox_arr_;
-  inline static Vec2DFlat<double> motion_res_map_;
-  inline static Vec2DFlat<double> temp_motion_res_map_;
-  inline static Vec2DFlat<double> obs_x_grad_;
-  inline static Vec2DFlat<double> temp_obs_x_grad_;
-  inline static Vec2DFlat<double> obs_y_grad_;
-  inline static Vec2DFlat<double> temp_obs_y_grad_;
+  Vec2DFlat<double> h_prox_arr_;
+  Vec2DFlat<double> temp_h_prox_arr_;
+  Vec2DFlat<double> motion_res_map_;
+  Vec2DFlat<double> temp_motion_res_map_;
+  Vec2DFlat<double> obs_x_grad_;
+  Vec2DFlat<double> temp_obs_x_grad_;
+  Vec2DFlat<double> obs_y_grad_;
+  Vec2DFlat<double> temp_obs_y_grad_;
+  Vec2DFlat<uint8_t> vor_grid_cache_;
+  Vec2DFlat<uint8_t> temp_vor_grid_cache_;
+
+  std::vector<size_t> path_indices_;
 
-  inline static std::vector<size_t> path_indices_;
+  AStar(const CollisionChecker& collision_checker, const grid_tf& transforms)
+    : collision_checker_(collision_checker), grid_tf_(transforms)
+  {
+  }
 
-  static void initialize(int patch_dim, const Point<double>& patch_origin_utm, const std::string& path2config);
+  void initialize(int patch_dim, const Point<double>& patch_origin_utm, const std::string& path2config);
 
-  static void init_structs(int patch_dim);
+  void init_structs(int patch_dim);
 
-  static void reinit(const Point<double>& patch_origin_utm, int patch_dim);
+  void reinit(const Point<double>& patch_origin_utm, int patch_dim);
 
-  static std::pair<std::vector<int>, std::vector<int>> getAstarPath(int x_ind, int y_ind);
+  std::pair<std::vector<int>, std::vector<int>> getAstarPath(int x_ind, int y_ind);
 
-  static py::array_t<double> getObsGradX();
+  py::array_t<double> getObsGradX() const;
 
-  static py::array_t<double> getObsGradY();
+  py::array_t<double> getObsGradY() const;
 
-  static void calcDistanceHeuristic(const Point<int>& goal_pos,
-                                    const Point<int>& start_pos,
-                                    bool for_path = true,
-                                    bool get_only_near = false);
+  void calcDistanceHeuristic(const Point<int>& goal_pos,
+                             const Point<int>& start_pos,
+                             bool for_path = true,
+                             bool get_only_near = false);
 
-  static std::unordered_map<size_t, NodeDisc> getDistanceHeuristic(bool for_path = false);
+  void calcGoalHeuristic(const Point<int>& goal_pos, const Point<int>& start_pos, HeuristicBuffers& buffers) const;
 
-  static void calcVoronoiPotentialField(const Point<int>& ego_index);
+  std::unordered_map<size_t, NodeDisc> getDistanceHeuristic(bool for_path = false);
 
-  static std::pair<size_t, size_t> reverse2DIndex(size_t idx);
+  std::shared_ptr<const std::vector<NodeDiscRecord>> getDistanceHeuristicNodes(bool for_path = false);
 
-  static void calcAstarGridCuda();
+  void calcVoronoiPotentialField(const Point<int>& ego_index);
 
-  //  static void calcAstarGrid();
+  void calcVoronoiPotentialFieldFortune(const Point<int>& ego_index);
 
-  static size_t calcIndex(size_t x_ind, size_t y_ind);
+  void calcVoronoiPotentialFieldEdt();
 
-  static size_t calcIndex(const NodeDisc& node);
+  std::pair<size_t, size_t> reverse2DIndex(size_t idx);
 
-  static void resetMovementMap();
+  void calcAstarGrid();
 
-  static void setMovementMap(const LaneGraph::edges_t& edges);
+  void calcAstarGridCpu();
+
+#ifdef USE_CUDA
+  void calcAstarGridCuda();
+#endif
+
+  size_t calcIndex(size_t x_ind, size_t y_ind) const;
+
+  size_t calcIndex(const NodeDisc& node) const;
+
+  void resetMovementMap();
+
+  void setMovementMap(const LaneGraph::edges_t& edges);
 
 private:
-  static int findValidNeighborIndex(int start_idx, std::unordered_map<size_t, NodeDisc> heuristic);
+  int findValidNeighborIndex(int start_idx, const NodeDiscGrid& heuristic);
+
+  void searchFromGoal(const Point<int>& goal_pos,
+                      const Point<int>& start_pos,
+                      bool get_only_near,
+                      NodeDiscGrid& node_grid,
+                      IndexedPriorityQueue<size_t, double>& frontier,
+                      BucketQueue<size_t, double>& bucket_frontier,
+                      std::vector<std::pair<double, NodeDisc>>& nodes_near_goal) const;
+
+  template <typename Frontier>
+  void expandDistanceHeuristic(Frontier& frontier,
+                               NodeDiscGrid& node_grid,
+                               size_t goal_id,
+                               const NodeDisc& start_node,
+                               bool get_only_near,
+                               std::vector<std::pair<double, NodeDisc>>& nodes_near_goal,
+                               const std::vector<uint8_t>* repair_region = nullptr) const;
+
+  bool repairGuidanceHeuristic(const Point<int>& goal_pos, const Point<int>& start_pos);
+
+  void saveGuidanceInputs(const Point<int>& goal_pos);
+
+  double calcStepCost(const Point<int>& from, size_t motion_idx) const;
+
+  void calcVorFieldElement(const std::array<double, 2>& query_vec,
+                           const my_kd_tree_t& obs_mat_index,
+                           const my_kd_tree_t& vor_mat_index);
+
+  void setVorFieldElement(int x_ind, int y_ind, double d_o, double d_v, double obs_dist_x, double obs_dist_y);
+
+  void markDirtyVoronoiTiles(int tile_pad);
+
+  void calcVoronoiWindowEdt(const Point<int>& window_min,
+                            const Point<int>& window_max,
+                            const Point<int>& out_min,
+                            const Point<int>& out_max);
 
-  static void calcVorFieldElement(const std::array<double, 2>& query_vec,
-                                  const my_kd_tree_t& obs_mat_index,
-                                  const my_kd_tree_t& vor_mat_index);
+  void calcVoronoiEdgeCells(int x_dim, int y_dim);
 
-  static std::array<double, NB_GRID_MOTIONS> getMovementDists();
+  std::array<double, NB_GRID_MOTIONS> getMovementDists();
 
-  static bool verifyNode(int x_ind, int y_ind);
+  bool verifyNode(int x_ind, int y_ind) const;
 
-  static Point<int> getCurrentMapOrigin(const Point<int>& ego_pos, size_t dim);
+  Point<int> getCurrentMapOrigin(const Point<int>& ego_pos, size_t dim);
 };
 
 #endif  // FREESPACE_PLANNER_A_STAR_HPP
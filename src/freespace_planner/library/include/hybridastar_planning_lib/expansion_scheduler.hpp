@@ -0,0 +1,55 @@
+#ifndef FREESPACE_PLANNER_EXPANSION_SCHEDULER_HPP
+#define FREESPACE_PLANNER_EXPANSION_SCHEDULER_HPP
+
+#include <cstdint>
+#include <random>
+
+/**
+ * Decides for every closed node whether the analytic expansions to the goal are tried. The probability of an attempt
+ * rises linearly from zero at the distance threshold to one at the goal. The random mode draws against it from a
+ * generator that is seeded again for every search, the cadence mode accumulates the probabilities and tries an
+ * expansion whenever they sum up to one. Both modes are reproducible and own their state, so they are independent of
+ * other users of a global generator. The statistics of the last search show how often an attempt paid off.
+ */
+class ExpansionScheduler
+{
+public:
+  enum Mode
+  {
+    RANDOM,
+    CADENCE
+  };
+
+  struct Stats
+  {
+    size_t nb_checks = 0;
+    size_t nb_attempts = 0;
+    size_t nb_rs_found = 0;
+    size_t nb_ra_found = 0;
+    double attempt_time_ms = 0;
+  };
+
+  void configure(Mode mode, double dist_thresh, uint64_t seed);
+
+  void reset();
+
+  bool shouldExpand(double dist2goal);
+
+  void recordAttempt(bool rs_found, bool ra_found, double time_ms);
+
+  [[nodiscard]] const Stats& getStats() const
+  {
+    return stats_;
+  }
+
+private:
+  Mode mode_ = RANDOM;
+  double dist_thresh_ = 0;
+  uint64_t seed_ = 0;
+  std::mt19937_64 generator_;
+  std::uniform_real_distribution<double> distribution_{ 0.0, 1.0 };
+  double credit_ = 0;
+  Stats stats_;
+};
+
+#endif  // FREESPACE_PLANNER_EXPANSION_SCHEDULER_HPP
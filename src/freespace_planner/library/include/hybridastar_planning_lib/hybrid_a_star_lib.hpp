@@ -11,9 +11,15 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <sstream>
 #include <chrono>
+#include <bit>
+#include <atomic>
+#include <functional>
 
+#include "util_lib/cancellation_token.hpp"
 #include "util_lib/data_structures2.hpp"
+#include "util_lib/thread_pool.hpp"
 #include "util_lib/util1.hpp"
 #include "util_lib/transforms.hpp"
 
@@ -26,10 +32,14 @@
 #include "deps_lib/BSpline1D.hpp"
 
 #include "a_star.hpp"
+#include "primitive_cache.hpp"
+#include "nonh_table.hpp"
+#include "expansion_scheduler.hpp"
 #include "smoother.hpp"
 
 /**
- * Main class of the Hybrid A* Algorithm that contains all necessary functions and variables
+ * Main class of the Hybrid A* Algorithm that contains all necessary functions and variables. Every planner context has
+ * its own search state, the modules it plans on are passed in
  */
 class HybridAStar
 {
@@ -41,184 +51,290 @@ private:
     NONE
   };
   inline static constexpr double OUT_OF_HEURISTIC = 999999999;
-  inline static std::string path2data_;
 
-  inline static Point<double> patch_origin_utm_;
+  // Modules of the same planner context
+  const Vehicle& vehicle_;
+  grid_tf& grid_tf_;
+  CollisionChecker& collision_checker_;
+  Cartographing& cartographing_;
+  AStar& astar_;
+  Smoother& smoother_;
+
+  std::string path2data_;
+
+  Point<double> patch_origin_utm_;
 
   inline static constexpr int NB_STEER = 13;
   inline static constexpr int NB_DIR = 2;
   inline static constexpr int NB_CONTROLS = NB_STEER * NB_DIR;
 
-  // Parameters
-  inline static double gm_res_;
-  inline static double astar_res_;
-  inline static double astar_yaw_res_;
-  inline static int astar_yaw_res_deg_;
-  inline static size_t astar_yaw_dim_;
-  inline static double a_star_yaw_res_inv_;
-  inline static int min_yaw_idx_;
-  inline static double arc_l_;
-  inline static size_t max_extra_nodes_;
-  inline static std::array<double, NB_STEER> steering_inputs_;
-  inline static std::array<int, 2> direction_inputs_;
-  inline static double approx_goal_angle_rad_;
-  inline static double approx_goal_dist2_;
-  inline static double dist_thresh_analytic_;
-  inline static double max_brake_acc_;
-  inline static double second_rs_steer_factor_;
-  inline static double extra_steer_cost_analytic_;
-  inline static bool can_turn_on_point_;
-  inline static double turn_on_point_horizon_;
-  inline static double yaw_res_coll_;
-  inline static double rear_axis_cost_;
-  inline static int timeout_ms_;
-  inline static double motion_res_min_;
-  inline static double motion_res_max_;
-  inline static double interp_res_;
-  inline static double turn_on_point_angle_;
-  inline static int rear_axis_freq_;
-  inline static int waypoint_dist_;
-  inline static WaypointType waypoint_type_;
-  inline static bool is_sim_ = false;
-
-  inline static size_t non_h_no_obs_patch_dim_;
-  inline static bool non_h_no_obs_calculated_ = false;
-
-  inline static std::set<size_t> visited_nodes_indices_;
-  inline static std::unordered_set<size_t> narrow_set_;
-  inline static std::unordered_set<size_t> collision_indices_;
-  inline static std::unordered_set<size_t> reachable_indices_;
-
-  // To be visited and visited set of nodes
-  inline static std::unordered_map<size_t, NodeHybrid> closed_set_;
-  inline static std::unordered_map<size_t, NodeHybrid> open_set_;
-  inline static std::vector<NodeHybrid> neighbors_;
+  /**
+   * Parameters from the config, a planner that shares the environment of another one takes them over as a whole
+   */
+  struct Parameters
+  {
+    double gm_res = 0;
+    double astar_res = 0;
+    double astar_yaw_res = 0;
+    int astar_yaw_res_deg = 0;
+    size_t astar_yaw_dim = 0;
+    double a_star_yaw_res_inv = 0;
+    int min_yaw_idx = 0;
+    double arc_l = 0;
+    size_t max_extra_nodes = 0;
+    std::array<double, NB_STEER> steering_inputs = {};
+    std::array<int, 2> direction_inputs = {};
+    double approx_goal_angle_rad = 0;
+    double approx_goal_dist2 = 0;
+    double dist_thresh_analytic = 0;
+    double max_brake_acc = 0;
+    double second_rs_steer_factor = 0;
+    double extra_steer_cost_analytic = 0;
+    bool can_turn_on_point = false;
+    double turn_on_point_horizon = 0;
+    double yaw_res_coll = 0;
+    double rear_axis_cost = 0;
+    int timeout_ms = 0;
+    size_t deadline_check_interval = 1;
+    bool partial_path = false;
+    double anytime_inflation_start = 1;
+    double anytime_inflation_step = 0;
+    int anytime_timeout_ms = 0;
+    double motion_res_min = 0;
+    double motion_res_max = 0;
+    double interp_res = 0;
+    double turn_on_point_angle = 0;
+    int rear_axis_freq = 0;
+    int waypoint_dist = 0;
+    WaypointType waypoint_type = NONE;
+    bool is_sim = false;
+    size_t non_h_no_obs_patch_dim = 0;
+    int nonh_table_type = NonhTable::FLOAT32;
+    size_t nonh_table_threads = 0;
+    bool nonh_table_symmetric = true;
+  };
+  Parameters params_;
+
+  bool non_h_no_obs_calculated_ = false;
+
+  std::set<size_t> visited_nodes_indices_;
+  std::unordered_set<size_t> narrow_set_;
+  std::unordered_set<size_t> collision_indices_;
+  std::unordered_set<size_t> reachable_indices_;
+
+  // To be visited and visited set of nodes, addressed by the unique state index
+  NodePool<NodeHybrid> node_pool_;
+  // The last search stopped on timeout or cancel and returned the closed node closest to the goal
+  bool is_partial_ = false;
+  // Factor of the heuristic, only above 1 during the anytime planning
+  double inflation_ = 1;
+  std::vector<NodeHybrid> neighbors_;
+
+  // Continuous poses of the nodes of the search and of the neighbors of the current expansion
+  TrajectoryArena traj_arena_;
+  TrajectoryArena neighbor_traj_;
+
+  // Parallel expansion, one output slot per control input which are merged in control order
+  ThreadPool expansion_pool_;
+  std::array<std::optional<NodeHybrid>, NB_CONTROLS> control_nodes_;
+  std::array<TrajectoryArena, NB_CONTROLS> control_traj_;
+
+  // Motion primitives of all controls, shared by all searches
+  PrimitiveCache primitive_cache_;
 
   // Vis states
-  inline static std::pair<std::vector<double>, std::vector<double>> connected_closed_nodes_;
+  std::pair<std::vector<double>, std::vector<double>> connected_closed_nodes_;
+  RecordBuffer<NodeHybridRecord> closed_records_;
+  RecordBuffer<NodeHybridRecord> open_records_;
 
   // Create priority queue
-  inline static PriorityQueue<size_t, double> open_queue_;
+  IndexedPriorityQueue<size_t, double> open_queue_;
+
+  // Non-holonomic-without-obstacles heuristic, mapped from the shared cache file
+  NonhTable non_h_no_obs_;
 
-  inline static Vec3DFlat<double> non_h_no_obs_;
+  // Decides when the analytic expansions are tried, restarted for every search
+  ExpansionScheduler expansion_scheduler_;
+
+  // Primitives and heuristic table the search reads, the own ones or the ones of the planner whose environment is
+  // shared by shareEnvironment
+  const PrimitiveCache* primitives_ = &primitive_cache_;
+  const NonhTable* nonh_table_ = &non_h_no_obs_;
 
 public:
-  inline static double switch_cost_;
-  inline static double steer_cost_;
-  inline static double steer_change_cost_;
-  inline static double h_dist_cost_;
-  inline static double back_cost_;
-  inline static double h_prox_cost_;
+  /**
+   * Optional inputs of a search besides the environment
+   */
+  struct SearchOptions
+  {
+    // Guidance heuristic of the goal, e.g. from AStar::calcGoalHeuristic, replaces the one of the environment
+    const NodeDiscGrid* goal_heuristic = nullptr;
+    // Costs of the best path found so far, e.g. by a search to another goal
+    const std::atomic<double>* cost_bound = nullptr;
+    // Stops the search from another thread
+    const CancellationToken* cancel_token = nullptr;
+  };
+
+  // Receives the improved paths of the anytime planning, the heuristic inflation they were found with and if they are
+  // smoothed
+  using PathCallback = std::function<void(const Path& path, double inflation, bool smoothed)>;
+
+  double switch_cost_ = 0;
+  double steer_cost_ = 0;
+  double steer_change_cost_ = 0;
+  double h_dist_cost_ = 0;
+  double back_cost_ = 0;
+  double h_prox_cost_ = 0;
 
   // Lanes that can be used
-  inline static LaneGraph lane_graph_;
+  LaneGraph lane_graph_;
+
+  HybridAStar(const Vehicle& vehicle,
+              grid_tf& transforms,
+              CollisionChecker& collision_checker,
+              Cartographing& cartographing,
+              AStar& astar,
+              Smoother& smoother);
 
-  static void initialize(int patch_dim, const Point<double>& patch_origin_utm, const std::string& lib_share_dir);
+  void initialize(int patch_dim, const Point<double>& patch_origin_utm, const std::string& lib_share_dir);
 
-  static void reinit(const Point<double>& patch_origin_utm, int patch_dim);
+  void reinit(const Point<double>& patch_origin_utm, int patch_dim);
 
-  static void setSim(bool is_sim)
+  void shareEnvironment(HybridAStar& planner);
+
+  void setSim(bool is_sim)
   {
-    is_sim_ = is_sim;
+    params_.is_sim = is_sim;
   }
 
-  static NodeHybrid createNode(const Pose<double>& pose, double steer);
+  NodeHybrid createNode(const Pose<double>& pose, double steer);
+
+  void recalculateEnv(const NodeHybrid& goal_node, const NodeHybrid& ego_node);
+
+  std::optional<Path> hybridAStarPlanning(const NodeHybrid& ego_node,
+                                          const NodeHybrid& start_node,
+                                          const NodeHybrid& goal_node,
+                                          bool to_final_pose,
+                                          bool do_analytic);
 
-  static void recalculateEnv(const NodeHybrid& goal_node, const NodeHybrid& ego_node);
+  std::optional<Path> planPath(const NodeHybrid& ego_node,
+                               const NodeHybrid& start_node,
+                               const NodeHybrid& goal_node,
+                               bool to_final_pose,
+                               bool do_analytic,
+                               const SearchOptions& options);
 
-  static std::optional<Path> hybridAStarPlanning(const NodeHybrid& ego_node,
-                                                 const NodeHybrid& start_node,
+  std::optional<Path> hybridAStarAnytimePlanning(const NodeHybrid& start_node,
                                                  const NodeHybrid& goal_node,
-                                                 bool to_final_pose,
-                                                 bool do_analytic);
+                                                 const PathCallback& on_path,
+                                                 const SearchOptions& options);
+
+  std::unordered_map<size_t, NodeHybrid> getClosedSet();
+
+  std::pair<std::vector<double>, std::vector<double>> getConnectedClosedNodes();
 
-  static std::unordered_map<size_t, NodeHybrid> getClosedSet();
+  std::unordered_map<size_t, NodeHybrid> getOpenSet();
 
-  static std::pair<std::vector<double>, std::vector<double>> getConnectedClosedNodes();
+  std::shared_ptr<const std::vector<NodeHybridRecord>> getClosedNodes();
+
+  std::shared_ptr<const std::vector<NodeHybridRecord>> getOpenNodes();
+
+  const ExpansionScheduler::Stats& getExpansionStats() const
+  {
+    return expansion_scheduler_.getStats();
+  }
 
-  static std::unordered_map<size_t, NodeHybrid> getOpenSet();
+  double getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybrid& goal_node);
 
-  static double getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybrid& goal_node);
+  py::array getNonhnoobsTable() const;
 
-  static std::pair<double, double> getMaxMeanProximity(const Path& path);
+  std::pair<double, double> getMaxMeanProximity(const Path& path);
 
-  static std::pair<double, double> getMaxMeanProximityVec(const std::vector<double>& x_list,
-                                                          const std::vector<double>& y_list);
+  std::pair<double, double> getMaxMeanProximityVec(const std::vector<double>& x_list,
+                                                   const std::vector<double>& y_list);
 
-  static double getDistance2GlobalGoal(const NodeHybrid& node);
+  double getDistance2GlobalGoal(const NodeHybrid& node);
 
   static std::tuple<Pose<double>, int, double> projEgoOnPath(const Pose<double>& pose, const Path& path, int ego_idx);
 
-  static std::optional<Pose<double>> getValidClosePose(const Pose<double>& ego_pose, const Pose<double>& goal_pose);
+  std::optional<Pose<double>> getValidClosePose(const Pose<double>& ego_pose, const Pose<double>& goal_pose);
 
-  static void resetLaneGraph();
+  void resetLaneGraph();
 
-  static void updateLaneGraph(const Point<double>& origin_utm, double patch_dim);
+  void updateLaneGraph(const Point<double>& origin_utm, double patch_dim);
 
   static void smoothPositions(std::vector<Point<double>>& positions);
 
   static void smoothLaneNodes(std::vector<LaneNode>& nodes);
 
-  static void interpolateLaneNodes(std::vector<LaneNode>& nodes);
+  void interpolateLaneNodes(std::vector<LaneNode>& nodes);
 
   static void smoothLaneGraph(LaneGraph& lane_graph);
 
-  static void interpolateLaneGraph(LaneGraph& lane_graph);
+  void interpolateLaneGraph(LaneGraph& lane_graph);
 
 private:
-  static std::array<double, HybridAStar::NB_STEER> calcSteeringInputs();
+  std::array<double, HybridAStar::NB_STEER> calcSteeringInputs();
 
-  static size_t calculateIndex(size_t x_index, size_t y_index, int yaw_index);
+  size_t calculateIndex(size_t x_index, size_t y_index, int yaw_index);
 
-  static double calcCost(const NodeHybrid& node,
-                         const NodeHybrid& goal_node,
-                         const std::unordered_map<size_t, NodeDisc>& h_dp);
+  size_t getNbStates();
 
-  static bool anglesApproxEqual02Pi(double angle1, double angle2);
+  double calcCost(const NodeHybrid& node, const NodeHybrid& goal_node, const NodeDiscGrid& h_dp);
 
-  static bool verifyIndex(int x_index, int y_index);
+  bool anglesApproxEqual02Pi(double angle1, double angle2);
 
-  static double getProxOfCorners(const Pose<double>& point);
+  bool verifyIndex(int x_index, int y_index);
 
-  static double
+  double getProxOfCorners(const Pose<double>& point);
+
+  double
   getPathCosts(int x_ind, int y_ind, double yaw, const NodeHybrid& node, double steer, int direction, double arc_l);
 
-  static std::optional<NodeHybrid> calcRearAxisNode(const NodeHybrid& node, double delta_angle);
+  std::optional<NodeHybrid> calcRearAxisNode(const NodeHybrid& node, double delta_angle);
 
-  static Pose<int> mapCont2Disc(const MotionPrimitive& motion_primitive);
+  Pose<int> mapCont2Disc(const MotionPrimitive& motion_primitive);
 
-  static std::optional<NodeHybrid>
-  calcNextNode(const NodeHybrid& node, double steer, int direction, double motion_res, double arc_len);
+  std::optional<NodeHybrid> calcNextNode(const NodeHybrid& node,
+                                         size_t control_idx,
+                                         double motion_res,
+                                         double arc_len,
+                                         TrajectoryArena& traj_out);
 
-  static void setNeighbors(const NodeHybrid& current, std::vector<NodeHybrid>& neighbors, double motion_res);
+  void setNeighbors(const NodeHybrid& current, std::vector<NodeHybrid>& neighbors, double motion_res);
 
-  static double getDistance2goal(const NodeHybrid& node, const std::unordered_map<size_t, NodeDisc>& h_dp);
+  double getDistance2goal(const NodeHybrid& node, const NodeDiscGrid& h_dp);
 
-  static double getTurnCost(double delta_angle);
+  double getTurnCost(double delta_angle);
 
-  static double getRAPathCosts(ReedsSheppStateSpace::ReedsSheppPath path);
+  double getRAPathCosts(ReedsSheppStateSpace::ReedsSheppPath path);
 
-  static double getRSPathCosts(ReedsSheppStateSpace::ReedsSheppPath path);
+  double getRSPathCosts(ReedsSheppStateSpace::ReedsSheppPath path);
 
-  static ReedsSheppStateSpace::ReedsSheppPath
-  getReedSheppPath(const Pose<double>& start, const Pose<double>& goal, double step_size, double rho);
+  std::optional<NodeHybrid> getRearAxisPath(const NodeHybrid& current_node, const NodeHybrid& goal_node);
 
-  static std::optional<NodeHybrid> getRearAxisPath(const NodeHybrid& current_node, const NodeHybrid& goal_node);
+  Path getFinalPath(const NodeHybrid& final_node, const NodePool<NodeHybrid>& node_pool);
 
-  static Path getFinalPath(const NodeHybrid& final_node, const std::unordered_map<size_t, NodeHybrid>& closet_set);
+  Path finishPath(const NodeHybrid& final_node);
 
-  static bool check4Expansions(const NodeHybrid& node, const std::unordered_map<size_t, NodeDisc>& h_dp);
+  std::shared_ptr<const std::vector<NodeHybridRecord>> fillNodeRecords(NodePool<NodeHybrid>::STATUS status,
+                                                                       RecordBuffer<NodeHybridRecord>& buffer);
 
-  static std::optional<ReedsSheppStateSpace::ReedsSheppPath> getRSExpansionPath(const NodeHybrid& current,
-                                                                                const NodeHybrid& goal);
+  bool check4Expansions(const NodeHybrid& node, const NodeDiscGrid& h_dp);
 
-  static std::optional<NodeHybrid> getRSExpansion(const NodeHybrid& current, const NodeHybrid& goal);
+  bool sampleCollisionFreeRSPath(const ReedsSheppStateSpace& state_space,
+                                 const Pose<double>& start,
+                                 const Pose<double>& goal,
+                                 ReedsSheppStateSpace::ReedsSheppPath& path);
 
-  static double getDrivenAngleDiff(double angle1, double angle2, char direction);
+  std::optional<ReedsSheppStateSpace::ReedsSheppPath> getRSExpansionPath(const NodeHybrid& current,
+                                                                         const NodeHybrid& goal);
 
-  static void recalculateLength(ReedsSheppStateSpace::ReedsSheppPath& path);
+  std::optional<NodeHybrid> getRSExpansion(const NodeHybrid& current, const NodeHybrid& goal);
+
+  static double getDrivenAngleDiff(double angle1, double angle2, char direction);
 
-  static void calculateNonhnoobs();
+  void calculateNonhnoobs();
 
   static std::vector<double> angleArange(double angle1, double angle2, char direction, double angle_res);
 
@@ -232,16 +348,27 @@ private:
                                Point<double>& intersect_point,
                                Point<double>& s2intersect);
 
-  static NodeHybrid getFinalNodeFromPath(const NodeHybrid& current,
-                                         const ReedsSheppStateSpace::ReedsSheppPath& analytic_path,
-                                         PATH_TYPE path_type,
-                                         double res);
+  NodeHybrid getFinalNodeFromPath(const NodeHybrid& current,
+                                  const ReedsSheppStateSpace::ReedsSheppPath& analytic_path,
+                                  PATH_TYPE path_type,
+                                  double res);
+
+  void resetSearch();
+
+  bool putStartNode(const NodeHybrid& start_node, const NodeHybrid& goal_node, const NodeDiscGrid& dist_heuristic);
+
+  void tryAnalyticExpansions(const NodeHybrid& current_node,
+                             const NodeHybrid& goal_node,
+                             std::vector<NodeHybrid>& final_nodes);
+
+  void expandNeighbors(const NodeHybrid& current_node, const NodeHybrid& goal_node, const NodeDiscGrid& dist_heuristic);
 
-  static std::optional<NodeHybrid> hAstarCore(const NodeHybrid& ego_node,
-                                              const NodeHybrid& start_node,
-                                              const NodeHybrid& goal_node,
-                                              bool to_final_pose,
-                                              bool do_analytic);
+  std::optional<NodeHybrid> hAstarCore(const NodeHybrid& ego_node,
+                                       const NodeHybrid& start_node,
+                                       const NodeHybrid& goal_node,
+                                       bool to_final_pose,
+                                       bool do_analytic,
+                                       const SearchOptions& options);
 
   static void interpolatePathSegment(Path& path, const Segment& segment_info, double interp_res);
 
@@ -0,0 +1,77 @@
+#ifndef FREESPACE_PLANNER_MULTI_GOAL_PLANNER_HPP
+#define FREESPACE_PLANNER_MULTI_GOAL_PLANNER_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "util_lib/data_structures2.hpp"
+#include "util_lib/thread_pool.hpp"
+#include "util_lib/transforms.hpp"
+
+#include "cartographing_lib/cartographing.hpp"
+
+#include "collision_checker_lib/collision_checking.hpp"
+#include "collision_checker_lib/vehicle.hpp"
+
+#include "a_star.hpp"
+#include "smoother.hpp"
+#include "hybrid_a_star_lib.hpp"
+
+/**
+ * Plans to several goal candidates, e.g. parking spots, in parallel. Every search has its own search state and goal
+ * heuristic, the patches, the grids of the 2D search and the tables of the hybrid planner are shared read only
+ */
+class MultiGoalPlanner
+{
+private:
+  // Search state of one goal at a time
+  struct Worker
+  {
+    HybridAStar planner;
+    AStar::HeuristicBuffers heuristic;
+
+    Worker(const Vehicle& vehicle,
+           grid_tf& transforms,
+           CollisionChecker& collision_checker,
+           Cartographing& cartographing,
+           AStar& astar,
+           Smoother& smoother)
+      : planner(vehicle, transforms, collision_checker, cartographing, astar, smoother)
+    {
+    }
+  };
+
+  // Modules of the same planner context, the environment of the hybrid planner is shared with the workers
+  const Vehicle& vehicle_;
+  grid_tf& grid_tf_;
+  CollisionChecker& collision_checker_;
+  Cartographing& cartographing_;
+  AStar& astar_;
+  Smoother& smoother_;
+  HybridAStar& hybrid_astar_;
+
+  bool is_initialized_ = false;
+  ThreadPool goal_pool_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+public:
+  MultiGoalPlanner(const Vehicle& vehicle,
+                   grid_tf& transforms,
+                   CollisionChecker& collision_checker,
+                   Cartographing& cartographing,
+                   AStar& astar,
+                   Smoother& smoother,
+                   HybridAStar& hybrid_astar);
+
+  void init();
+
+  std::vector<std::pair<size_t, Path>> plan(const NodeHybrid& ego_node,
+                                            const NodeHybrid& start_node,
+                                            const std::vector<NodeHybrid>& goal_nodes,
+                                            bool to_final_pose,
+                                            bool do_analytic,
+                                            bool only_best);
+};
+
+#endif  // FREESPACE_PLANNER_MULTI_GOAL_PLANNER_HPP
@@ -0,0 +1,159 @@
+#ifndef FREESPACE_PLANNER_NONH_TABLE_HPP
+#define FREESPACE_PLANNER_NONH_TABLE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Lookup table of the non-holonomic-without-obstacles heuristic, stored in a file with a header.
+ * The header contains a key hashed from all parameters the table depends on, a table of other parameters is never
+ * used. Valid files are memory mapped read only, so all planner processes on a machine share the same pages. The
+ * values are stored as float32 or float16, one slice per yaw index.
+ * The Reeds-Shepp distance to a goal at the origin with yaw 0 is the same after mirroring the start at the x-axis and,
+ * by reversing the gears, at the y-axis, each time with the negated yaw. The symmetric layout therefore only stores the
+ * quadrant with non-negative coordinates relative to the goal and maps the other quadrants on it, which needs about a
+ * quarter of the memory. The goal is at the center of the patch, so this requires an odd patch_dim.
+ * The values are owned by a shared pointer, so views on them stay valid after the table was loaded again.
+ */
+class NonhTable
+{
+public:
+  enum ValueType : uint32_t
+  {
+    FLOAT32,
+    FLOAT16
+  };
+
+  enum Layout : uint32_t
+  {
+    FULL,
+    SYMMETRIC
+  };
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t value_type;
+    uint32_t layout;
+    uint32_t yaw_dim;
+    uint32_t patch_dim;
+    uint32_t reserved;
+    uint64_t key;
+  };
+
+  inline static constexpr char MAGIC[8] = { 'N', 'O', 'N', 'H', 'T', 'B', 'L', '\0' };
+  inline static constexpr uint32_t VERSION = 2;
+
+  // Values of the consecutive cells from x_ind on in row y_ind of the full patch, the yaw index addresses the slice of
+  // yaw -180 deg + yaw_idx * yaw resolution
+  using RowGenerator = std::function<void(int yaw_idx, int y_ind, int x_ind, std::span<float> values)>;
+
+  NonhTable() = default;
+  NonhTable(const NonhTable&) = delete;
+  NonhTable& operator=(const NonhTable&) = delete;
+
+  bool load(const std::string& path, uint64_t key, int yaw_dim, int patch_dim, ValueType value_type, Layout layout);
+
+  void generate(const std::string& path,
+                uint64_t key,
+                int yaw_dim,
+                int patch_dim,
+                ValueType value_type,
+                Layout layout,
+                size_t nb_threads,
+                const RowGenerator& row_generator);
+
+  [[nodiscard]] double operator()(int yaw_idx, int y_ind, int x_ind) const
+  {
+    if (layout_ == SYMMETRIC)
+    {
+      // Mirror into the stored quadrant, every mirroring negates the yaw
+      x_ind -= center_;
+      y_ind -= center_;
+      if ((x_ind < 0) != (y_ind < 0))
+      {
+        yaw_idx = (yaw_dim_ - yaw_idx) % yaw_dim_;
+      }
+      x_ind = std::abs(x_ind);
+      y_ind = std::abs(y_ind);
+    }
+    const size_t index = (static_cast<size_t>(yaw_idx) * stored_dim_ + y_ind) * stored_dim_ + x_ind;
+    if (value_type_ == FLOAT16)
+    {
+      return fromHalf(reinterpret_cast<const uint16_t*>(values_)[index]);
+    }
+    return reinterpret_cast<const float*>(values_)[index];
+  }
+
+  [[nodiscard]] bool isMapped() const
+  {
+    return is_mapped_;
+  }
+
+  [[nodiscard]] const void* data() const
+  {
+    return values_;
+  }
+
+  // Values that share the ownership of the memory, either the mapped file or the own copy
+  [[nodiscard]] std::shared_ptr<const void> sharedData() const
+  {
+    return storage_;
+  }
+
+  [[nodiscard]] ValueType getValueType() const
+  {
+    return value_type_;
+  }
+
+  [[nodiscard]] int getYawDim() const
+  {
+    return yaw_dim_;
+  }
+
+  // Dimension of the stored x and y axes, smaller than the patch dim in the symmetric layout
+  [[nodiscard]] int getStoredDim() const
+  {
+    return stored_dim_;
+  }
+
+  [[nodiscard]] size_t getSizeBytes() const
+  {
+    return static_cast<size_t>(yaw_dim_) * stored_dim_ * stored_dim_ * valueSize(value_type_);
+  }
+
+  static int storedDim(int patch_dim, Layout layout);
+
+  static uint64_t hashKey(std::initializer_list<double> params);
+
+  static uint16_t toHalf(float value);
+
+  static float fromHalf(uint16_t value);
+
+private:
+  std::shared_ptr<const uint8_t> storage_;
+  const uint8_t* values_ = nullptr;
+  bool is_mapped_ = false;
+  ValueType value_type_ = FLOAT32;
+  Layout layout_ = FULL;
+  int yaw_dim_ = 0;
+  int stored_dim_ = 0;
+  int center_ = 0;
+
+  void setDims(int yaw_dim, int patch_dim, ValueType value_type, Layout layout);
+
+  void setStorage(std::shared_ptr<const uint8_t> storage, bool is_mapped);
+
+  void release();
+
+  static size_t valueSize(ValueType value_type);
+};
+
+#endif  // FREESPACE_PLANNER_NONH_TABLE_HPP
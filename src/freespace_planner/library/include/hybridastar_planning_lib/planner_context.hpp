@@ -0,0 +1,53 @@
+#ifndef FREESPACE_PLANNER_PLANNER_CONTEXT_HPP
+#define FREESPACE_PLANNER_PLANNER_CONTEXT_HPP
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "util_lib/transforms.hpp"
+
+#include "cartographing_lib/cartographing.hpp"
+
+#include "collision_checker_lib/collision_checking.hpp"
+#include "collision_checker_lib/vehicle.hpp"
+
+#include "a_star.hpp"
+#include "smoother.hpp"
+#include "hybrid_a_star_lib.hpp"
+#include "multi_goal_planner.hpp"
+
+/**
+ * Owns all modules of one planner: the vehicle, the transforms of its patch, the collision checker with its patches,
+ * the map, the 2D search, the smoother, the hybrid search and the parallel searches to several goals. The modules
+ * reference each other, so a context can not be copied or moved. Independent contexts can plan concurrently in one
+ * process, only the CUDA pooling is shared.
+ */
+class PlannerContext
+{
+public:
+  PlannerContext();
+  PlannerContext(const PlannerContext&) = delete;
+  PlannerContext& operator=(const PlannerContext&) = delete;
+
+  // The modules are constructed in this order, every module only references the ones above it
+  Vehicle vehicle_;
+  grid_tf grid_tf_;
+  CollisionChecker collision_checker_;
+  Cartographing cartographing_;
+  AStar astar_;
+  Smoother smoother_;
+  HybridAStar hybrid_astar_;
+  MultiGoalPlanner multi_goal_planner_;
+
+  // Calls that change the modules lock the context exclusively. A planning task locks it shared, as do the calls that
+  // only read or write the map patches, which the search does not read. So the map can be updated during a search
+  std::shared_mutex mutex_;
+  // Serializes the planning tasks, they share the lock of the context but use the same planner
+  std::mutex search_mutex_;
+  // Serializes the map updates and reads, they share the lock of the context with a planning task
+  std::mutex ingest_mutex_;
+
+  static PlannerContext& defaultContext();
+};
+
+#endif  // FREESPACE_PLANNER_PLANNER_CONTEXT_HPP
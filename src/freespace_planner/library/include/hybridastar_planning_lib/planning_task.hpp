@@ -0,0 +1,54 @@
+#ifndef FREESPACE_PLANNER_PLANNING_TASK_HPP
+#define FREESPACE_PLANNER_PLANNING_TASK_HPP
+
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+
+#include "util_lib/cancellation_token.hpp"
+#include "util_lib/data_structures2.hpp"
+
+#include "planner_context.hpp"
+
+/**
+ * Hybrid A* search of a planner context on its own thread. The task holds the lock of the context shared while it
+ * plans, so calls that change the modules and other tasks wait until it is done or cancelled. The map can be updated
+ * meanwhile
+ */
+class PlanningTask
+{
+public:
+  // Runs the search on the planner of the context, it has to pass the options with the cancel token to the planner
+  using Search = std::function<std::optional<Path>(HybridAStar& planner, const HybridAStar::SearchOptions& options)>;
+
+private:
+  CancellationToken token_;
+  std::promise<std::optional<Path>> promise_;
+  std::shared_future<std::optional<Path>> result_;
+
+  // Started last, after everything it uses is constructed
+  std::thread thread_;
+
+public:
+  PlanningTask(PlannerContext& context, Search search);
+  PlanningTask(PlannerContext& context,
+               const NodeHybrid& ego_node,
+               const NodeHybrid& start_node,
+               const NodeHybrid& goal_node,
+               bool to_final_pose,
+               bool do_analytic);
+  PlanningTask(const PlanningTask&) = delete;
+  PlanningTask& operator=(const PlanningTask&) = delete;
+  ~PlanningTask();
+
+  [[nodiscard]] bool poll() const;
+
+  bool wait(std::optional<double> timeout_s) const;
+
+  void cancel();
+
+  std::optional<Path> get() const;
+};
+
+#endif  // FREESPACE_PLANNER_PLANNING_TASK_HPP
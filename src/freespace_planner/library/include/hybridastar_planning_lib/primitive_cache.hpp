@@ -0,0 +1,151 @@
+#ifndef FREESPACE_PLANNER_PRIMITIVE_CACHE_HPP
+#define FREESPACE_PLANNER_PRIMITIVE_CACHE_HPP
+
+#include <cmath>
+#include <vector>
+
+#include "util_lib/data_structures2.hpp"
+#include "util_lib/util1.hpp"
+#include "collision_checker_lib/vehicle.hpp"
+#include "collision_checker_lib/collision_checking.hpp"
+
+/**
+ * Precomputed motion primitives of the hybrid A* expansion.
+ * A primitive only depends on the start yaw, the steering angle, the direction and the motion resolution, the start
+ * position is a pure offset. The cache stores the poses relative to the start for every discrete start yaw, control
+ * and motion resolution bucket, so an expansion only translates and rotates them by the residual yaw of the bin.
+ * Optionally, the unique collision cells swept by every primitive are stored for a few sub-cell phases of the start
+ * position, which turns the collision check of an expansion into a loop over precomputed cell offsets.
+ */
+class PrimitiveCache
+{
+public:
+  PrimitiveCache(const Vehicle& vehicle, const CollisionChecker& collision_checker, const grid_tf& transforms)
+    : vehicle_(vehicle), collision_checker_(collision_checker), grid_tf_(transforms)
+  {
+  }
+
+  /**
+   * Integrate all primitives, the controls are addressed by control_idx = steer_idx * nb_directions + dir_idx
+   * @param steering_inputs
+   * @param direction_inputs
+   * @param arc_l
+   * @param motion_res_min
+   * @param motion_res_max
+   * @param nb_res_buckets 0 disables the cache
+   * @param yaw_bin_res_rad
+   */
+  void build(const std::vector<double>& steering_inputs,
+             const std::vector<int>& direction_inputs,
+             double arc_l,
+             double motion_res_min,
+             double motion_res_max,
+             size_t nb_res_buckets,
+             double yaw_bin_res_rad);
+
+  [[nodiscard]] bool enabled() const
+  {
+    return !segments_.empty();
+  }
+
+  [[nodiscard]] size_t nbYawBins() const
+  {
+    return nb_yaw_bins_;
+  }
+
+  [[nodiscard]] size_t nbResBuckets() const
+  {
+    return res_buckets_.size();
+  }
+
+  [[nodiscard]] size_t getYawBin(double yaw) const
+  {
+    const auto yaw_bin = static_cast<size_t>(util::constrainAngleZero2Pi(yaw) / yaw_bin_res_);
+    return std::min(yaw_bin, nb_yaw_bins_ - 1);
+  }
+
+  /**
+   * Nearest motion resolution bucket, its resolution is used instead of the requested one
+   * @param motion_res
+   * @return
+   */
+  [[nodiscard]] size_t getResBucket(double motion_res) const;
+
+  [[nodiscard]] size_t getIndex(size_t yaw_bin, size_t control_idx, size_t res_bucket) const
+  {
+    return (yaw_bin * nb_controls_ + control_idx) * res_buckets_.size() + res_bucket;
+  }
+
+  /**
+   * Primitive of a control started at pose, equivalent to Vehicle::move_car_some_steps with the bucket resolution
+   * @param pose
+   * @param control_idx
+   * @param res_bucket
+   * @return
+   */
+  [[nodiscard]] MotionPrimitive apply(const Pose<double>& pose, size_t control_idx, size_t res_bucket) const;
+
+  /**
+   * Set the number of sub-cell phases per axis of the swept cell lists, 0 disables them
+   * @param nb_phases
+   */
+  void setFootprintPhases(size_t nb_phases);
+
+  [[nodiscard]] bool footprintsEnabled() const
+  {
+    return enabled() && nb_phases_ > 0;
+  }
+
+  /**
+   * Rebuild the swept cell lists if the disks of the collision checker changed since the last build
+   */
+  void updateFootprints();
+
+  /**
+   * Collision check of a primitive by its swept cells. The cells of a phase are the union of the cells swept from the
+   * corners of the phase with both limits of the yaw bin. Poses in between are not sampled, so the check is only
+   * approximately conservative compared to checkPathCollision, for ARC_L times the yaw bin width below the phase width
+   * @param pose
+   * @param control_idx
+   * @param res_bucket
+   * @return true if the primitive is valid
+   */
+  [[nodiscard]] bool checkFootprint(const Pose<double>& pose, size_t control_idx, size_t res_bucket) const;
+
+private:
+  // Offset of the footprint start cell, keeps all cells positive while they are computed
+  inline static constexpr int FOOTPRINT_ORIGIN = 1024;
+
+  // Integrates the primitives and checks the swept cells, owned by the planner context
+  const Vehicle& vehicle_;
+  const CollisionChecker& collision_checker_;
+  const grid_tf& grid_tf_;
+
+  size_t nb_controls_ = 0;
+  size_t nb_yaw_bins_ = 0;
+  double yaw_bin_res_ = 0;
+
+  std::vector<double> res_buckets_;
+  std::vector<int> directions_;
+
+  // Relative poses of all primitives, rotated to the yaw of their bin
+  std::vector<TrajSegment> segments_;
+  std::vector<double> dx_;
+  std::vector<double> dy_;
+  std::vector<double> dyaw_;
+
+  // Swept cells relative to the start cell, nb_phases_ x nb_phases_ variants per primitive
+  size_t nb_phases_ = 0;
+  size_t footprints_version_ = 0;
+  bool footprints_built_ = false;
+  std::vector<TrajSegment> footprint_segments_;
+  std::vector<Point<int>> footprint_cells_;
+
+  [[nodiscard]] size_t getPhase(double cell_coord) const
+  {
+    const double frac = cell_coord - std::floor(cell_coord);
+    return std::min(static_cast<size_t>(frac * static_cast<double>(nb_phases_)), nb_phases_ - 1);
+  }
+};
+
+#endif  // FREESPACE_PLANNER_PRIMITIVE_CACHE_HPP
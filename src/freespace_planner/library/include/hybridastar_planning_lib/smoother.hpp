@@ -19,34 +19,48 @@
 class Smoother
 {
 private:
-  inline static unsigned int max_iter_;
-  inline static double wSmoothness_;
-  inline static double wObstacle_;
-  inline static double wCurvature_;
-  inline static double alpha_;
-  inline static double kappaMax_;
-  inline static bool is_initialized_ = false;
+  // Gradients of the obstacle distances and the collision checks, owned by the planner context
+  const AStar& astar_;
+  const CollisionChecker& collision_checker_;
+  const Vehicle& vehicle_;
+  const grid_tf& grid_tf_;
+
+  unsigned int max_iter_ = 0;
+  double wSmoothness_ = 0;
+  double wObstacle_ = 0;
+  double wCurvature_ = 0;
+  double alpha_ = 0;
+  double kappaMax_ = 0;
+  bool is_initialized_ = false;
 
 public:
-  static void init();
+  Smoother(const AStar& astar,
+           const CollisionChecker& collision_checker,
+           const Vehicle& vehicle,
+           const grid_tf& transforms)
+    : astar_(astar), collision_checker_(collision_checker), vehicle_(vehicle), grid_tf_(transforms)
+  {
+  }
+
+  void init();
 
-  static void smooth_path(Path& path);
+  void smooth_path(Path& path);
 
-  static void optimize_gd(Path& path, const std::vector<int>& collision_indices);
+  void optimize_gd(Path& path, const std::vector<int>& collision_indices);
 
-  static Point<double> smoothnessTerm(const Point<double>& xim2,
-                                      const Point<double>& xim1,
-                                      const Point<double>& xi0,
-                                      const Point<double>& xip1,
-                                      const Point<double>& xip2);
+  Point<double> smoothnessTerm(const Point<double>& xim2,
+                               const Point<double>& xim1,
+                               const Point<double>& xi0,
+                               const Point<double>& xip1,
+                               const Point<double>& xip2);
 
-  static Point<double> curvatureTerm(const Point<double>& x_im2,
-                                     const Point<double>& x_im1,
-                                     const Point<double>& x_i,
-                                     const Point<double>& x_ip1,
-                                     const Point<double>& x_ip2);
+  Point<double> curvatureTerm(const Point<double>& x_im2,
+                              const Point<double>& x_im1,
+                              const Point<double>& x_i,
+                              const Point<double>& x_ip1,
+                              const Point<double>& x_ip2);
 
-  static Point<double> obsTerm(const Point<double>& xi0, const Point<double>& xip);
+  Point<double> obsTerm(const Point<double>& xi0, const Point<double>& xip);
 };
 
 #endif  // SMOOTHER_H
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef FREESPACE_PLANNER_CANCELLATION_TOKEN_HPP
+#define FREESPACE_PLANNER_CANCELLATION_TOKEN_HPP
+
+#include <atomic>
+
+/**
+ * Flag to stop a computation from another thread. The computation polls it and stops at the next check
+ */
+class CancellationToken
+{
+public:
+  void cancel()
+  {
+    cancelled_.store(true, std::memory_order_relaxed);
+  }
+
+  void reset()
+  {
+    cancelled_.store(false, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool isCancelled() const
+  {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<bool> cancelled_ = false;
+};
+
+#endif  // FREESPACE_PLANNER_CANCELLATION_TOKEN_HPP
@@ -8,6 +8,7 @@
 #include <ostream>
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <array>
 #include <cmath>
 #include <queue>
@@ -330,6 +331,60 @@ public:
   std::vector<Point<double>> vertices;
 };
 
+/**
+ * Read only numpy array on memory of the planner, nothing is copied. The base object must keep the memory alive
+ * @tparam T
+ * @param shape
+ * @param data
+ * @param base
+ * @return
+ */
+template <typename T>
+py::array_t<T> numpyView(const std::vector<py::ssize_t>& shape, const T* data, const py::handle& base)
+{
+  py::array_t<T> view(shape, data, base);
+  view.attr("setflags")(false);
+  return view;
+}
+
+/**
+ * Read only numpy array on a shared buffer, nothing is copied. The array shares the ownership of the buffer, so it
+ * stays valid after the owner of the buffer replaced it
+ * @tparam T
+ * @param shape
+ * @param storage
+ * @return
+ */
+template <typename T>
+py::array_t<T> numpyView(const std::vector<py::ssize_t>& shape, std::shared_ptr<const std::vector<T>> storage)
+{
+  using Owner = std::shared_ptr<const std::vector<T>>;
+  auto* owner = new Owner(std::move(storage));
+  const py::capsule base(owner, [](void* ptr) { delete static_cast<Owner*>(ptr); });
+
+  return numpyView<T>(shape, (*owner)->data(), base);
+}
+
+/**
+ * Read-only numpy view for data with a dtype that has no C++ type, the array keeps the shared storage alive.
+ * The storage points to the first value
+ * @param dtype
+ * @param shape
+ * @param storage
+ * @return
+ */
+inline py::array numpyView(const py::dtype& dtype,
+                           const std::vector<py::ssize_t>& shape,
+                           std::shared_ptr<const void> storage)
+{
+  using Owner = std::shared_ptr<const void>;
+  auto* owner = new Owner(std::move(storage));
+  const py::capsule base(owner, [](void* ptr) { delete static_cast<Owner*>(ptr); });
+  py::array arr(dtype, shape, (*owner).get(), base);
+  arr.attr("setflags")(false);
+  return arr;
+}
+
 /**
  * Flatten version of a 2D vector that can be indexed with 2D indices
  * @tparam T
@@ -338,13 +393,36 @@ template <typename T>
 class Vec2DFlat
 {
 private:
-  std::vector<T> vec_;
+  std::shared_ptr<std::vector<T>> vec_ = std::make_shared<std::vector<T>>();
   std::string name_ = "not set";
   // Dimensions in each direction
   int xDim_{};
   int yDim_{};
 
 public:
+  Vec2DFlat() = default;
+
+  // Copies own their memory, only views share it
+  Vec2DFlat(const Vec2DFlat& other)
+    : vec_(std::make_shared<std::vector<T>>(*other.vec_))
+    , name_(other.name_)
+    , xDim_(other.xDim_)
+    , yDim_(other.yDim_)
+  {
+  }
+
+  Vec2DFlat& operator=(const Vec2DFlat& other)
+  {
+    if (this != &other)
+    {
+      vec_ = std::make_shared<std::vector<T>>(*other.vec_);
+      name_ = other.name_;
+      xDim_ = other.xDim_;
+      yDim_ = other.yDim_;
+    }
+    return *this;
+  }
+
   [[nodiscard]] std::pair<int, int> getDims() const
   {
     return { xDim_, yDim_ };
@@ -352,7 +430,7 @@ public:
 
   [[nodiscard]] bool is_empty() const
   {
-    return vec_.empty();
+    return vec_->empty();
   }
 
   void setName(std::string name)
@@ -360,9 +438,26 @@ public:
     name_ = name;
   }
 
+  /**
+   * Read only view on the grid, indexed with [y, x]
+   * The view shares the current memory of the grid, the grid writes to a copy while the view is alive
+   * @return
+   */
   [[nodiscard]] py::array_t<T> getNumpyArr() const
   {
-    return py::array_t<T>({ xDim_, yDim_ }, vec_.data());
+    return numpyView<T>({ yDim_, xDim_ }, std::shared_ptr<const std::vector<T>>(vec_));
+  }
+
+  /**
+   * Copies the memory if a view still shares it, so the grid can be written without changing the view.
+   * Must be called before a grid is written, the writes themselves do not check it as they may run in parallel
+   */
+  void unshare()
+  {
+    if (vec_.use_count() > 1)
+    {
+      vec_ = std::make_shared<std::vector<T>>(*vec_);
+    }
   }
 
   void resize_and_reset(size_t x_dim, size_t y_dim, T val)
@@ -372,8 +467,14 @@ public:
      */
     xDim_ = x_dim;
     yDim_ = y_dim;
-    vec_.assign(x_dim * y_dim, val);
-    vec_.shrink_to_fit();
+    if (vec_.use_count() > 1)
+    {
+      // A view still shares the memory
+      vec_ = std::make_shared<std::vector<T>>(x_dim * y_dim, val);
+      return;
+    }
+    vec_->assign(x_dim * y_dim, val);
+    vec_->shrink_to_fit();
   }
 
   void resize(size_t x_dim, size_t y_dim)
@@ -383,8 +484,9 @@ public:
      */
     xDim_ = x_dim;
     yDim_ = y_dim;
-    vec_.resize(x_dim * y_dim);
-    vec_.shrink_to_fit();
+    unshare();
+    vec_->resize(x_dim * y_dim);
+    vec_->shrink_to_fit();
   }
 
   [[nodiscard]] T operator()(int y_index, int x_index) const
@@ -409,7 +511,7 @@ public:
       y_index = std::clamp(y_index, 0, yDim_);
     }
 
-    return vec_[y_index * xDim_ + x_index];
+    return (*vec_)[y_index * xDim_ + x_index];
   }
 
   [[nodiscard]] T operator()(const Point<int>& point) const
@@ -432,10 +534,10 @@ public:
     {
       int x = std::clamp(point.x, 0, xDim_);
       int y = std::clamp(point.y, 0, yDim_);
-      return vec_[y * xDim_ + x];
+      return (*vec_)[y * xDim_ + x];
     }
 
-    return vec_[point.y * xDim_ + point.x];
+    return (*vec_)[point.y * xDim_ + point.x];
   }
 
   [[nodiscard]] T& operator()(int y_index, int x_index)
@@ -459,7 +561,7 @@ public:
       y_index = std::clamp(y_index, 0, yDim_);
     }
 
-    return vec_[y_index * xDim_ + x_index];
+    return (*vec_)[y_index * xDim_ + x_index];
   }
 
   [[nodiscard]] T& operator()(const Point<int>& point)
@@ -482,15 +584,18 @@ public:
     {
       int x = std::clamp(point.x, 0, xDim_);
       int y = std::clamp(point.y, 0, yDim_);
-      return vec_[y * xDim_ + x];
+      return (*vec_)[y * xDim_ + x];
     }
 
-    return vec_[point.y * xDim_ + point.x];
+    return (*vec_)[point.y * xDim_ + point.x];
   }
 
   [[nodiscard]] std::vector<T> data() const
   {
-    return vec_;
+    /**
+     * This returns a copy of the vector, getPtr reads without copying
+     */
+    return *vec_;
   }
 
   [[nodiscard]] std::vector<T>& data_ref()
@@ -498,17 +603,18 @@ public:
     /**
      * This allows the modification of the inner vector
      */
-    return vec_;
+    unshare();
+    return *vec_;
   }
 
   T* getPtr()
   {
-    return vec_.data();
+    return vec_->data();
   }
 
-  [[nodiscard]] T* getPtr() const
+  [[nodiscard]] const T* getPtr() const
   {
-    return vec_.data();
+    return vec_->data();
   }
 };
 
@@ -520,7 +626,7 @@ template <typename T>
 class Vec3DFlat
 {
 private:
-  std::vector<T> vec_;
+  std::shared_ptr<std::vector<T>> vec_ = std::make_shared<std::vector<T>>();
   std::string name_ = "not set";
   // Dimensions in each direction
   int xDim_{};
@@ -528,6 +634,30 @@ private:
   int zDim_{};
 
 public:
+  Vec3DFlat() = default;
+
+  // Copies own their memory, only views share it
+  Vec3DFlat(const Vec3DFlat& other)
+    : vec_(std::make_shared<std::vector<T>>(*other.vec_))
+    , name_(other.name_)
+    , xDim_(other.xDim_)
+    , yDim_(other.yDim_), zDim_(other.zDim_)
+  {
+  }
+
+  Vec3DFlat& operator=(const Vec3DFlat& other)
+  {
+    if (this != &other)
+    {
+      vec_ = std::make_shared<std::vector<T>>(*other.vec_);
+      name_ = other.name_;
+      xDim_ = other.xDim_;
+      yDim_ = other.yDim_;
+      zDim_ = other.zDim_;
+    }
+    return *this;
+  }
+
   [[nodiscard]] std::tuple<int, int, int> getDims() const
   {
     return { xDim_, yDim_, zDim_ };
@@ -535,7 +665,7 @@ public:
 
   [[nodiscard]] bool is_empty() const
   {
-    return vec_.empty();
+    return vec_->empty();
   }
 
   void setName(std::string name)
@@ -543,6 +673,28 @@ public:
     name_ = name;
   }
 
+  /**
+   * Read only view on the grid, indexed with [yaw, y, x]
+   * The view shares the current memory of the grid, the grid writes to a copy while the view is alive
+   * @return
+   */
+  [[nodiscard]] py::array_t<T> getNumpyArr() const
+  {
+    return numpyView<T>({ zDim_, yDim_, xDim_ }, std::shared_ptr<const std::vector<T>>(vec_));
+  }
+
+  /**
+   * Copies the memory if a view still shares it, so the grid can be written without changing the view.
+   * Must be called before a grid is written, the writes themselves do not check it as they may run in parallel
+   */
+  void unshare()
+  {
+    if (vec_.use_count() > 1)
+    {
+      vec_ = std::make_shared<std::vector<T>>(*vec_);
+    }
+  }
+
   void resize_and_reset(size_t x_dim, size_t y_dim, size_t yaw_dim, T val)
   {
     /*
@@ -551,8 +703,14 @@ public:
     xDim_ = x_dim;
     yDim_ = y_dim;
     zDim_ = yaw_dim;
-    vec_.assign(x_dim * y_dim * yaw_dim, val);
-    vec_.shrink_to_fit();
+    if (vec_.use_count() > 1)
+    {
+      // A view still shares the memory
+      vec_ = std::make_shared<std::vector<T>>(x_dim * y_dim * yaw_dim, val);
+      return;
+    }
+    vec_->assign(x_dim * y_dim * yaw_dim, val);
+    vec_->shrink_to_fit();
   }
 
   [[nodiscard]] T operator()(int x_index, int y_index, int yaw_index) const
@@ -583,12 +741,12 @@ public:
       yaw_index = std::clamp(y_index, 0, zDim_);
     }
 
-    return vec_[yaw_index * yDim_ * xDim_ + y_index * xDim_ + x_index];
+    return (*vec_)[yaw_index * yDim_ * xDim_ + y_index * xDim_ + x_index];
   }
 
   [[nodiscard]] T getVal(int x_index, int y_index, int yaw_index) const
   {
-    return vec_[yaw_index * yDim_ * xDim_ + y_index * xDim_ + x_index];
+    return (*vec_)[yaw_index * yDim_ * xDim_ + y_index * xDim_ + x_index];
   }
 
   [[nodiscard]] T& operator()(int x_index, int y_index, int yaw_index)
@@ -619,7 +777,7 @@ public:
       yaw_index = std::clamp(y_index, 0, zDim_);
     }
 
-    return vec_[yaw_index * yDim_ * xDim_ + y_index * xDim_ + x_index];
+    return (*vec_)[yaw_index * yDim_ * xDim_ + y_index * xDim_ + x_index];
   }
 
   [[nodiscard]] std::vector<T> data() const
@@ -627,7 +785,7 @@ public:
     /**
      * This returns the actual vector
      */
-    return vec_;
+    return *vec_;
   }
 
   [[nodiscard]] std::vector<T>& data_ref()
@@ -635,17 +793,18 @@ public:
     /**
      * This allows the modification of the inner vector
      */
-    return vec_;
+    unshare();
+    return *vec_;
   }
 
   [[nodiscard]] T* getPtr()
   {
-    return vec_.data();
+    return vec_->data();
   }
 
-  [[nodiscard]] T* getPtr() const
+  [[nodiscard]] const T* getPtr() const
   {
-    return vec_.data();
+    return vec_->data();
   }
 };
 
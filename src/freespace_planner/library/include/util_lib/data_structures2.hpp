@@ -5,6 +5,7 @@
 #ifndef FREESPACE_PLANNER_DATA_STRUCTURES2_HPP
 #define FREESPACE_PLANNER_DATA_STRUCTURES2_HPP
 
+#include <memory>
 #include <vector>
 
 #include "data_structures1.hpp"
@@ -63,6 +64,169 @@ public:
   bool is_unknown_;
 };
 
+/**
+ * Dense storage of the nodes of the 2D A* search, one entry per cell of the A* grid.
+ * Only closed nodes belong to the calculated heuristic, open nodes keep their tentative costs
+ */
+class NodeDiscGrid
+{
+public:
+  enum STATUS : uint8_t
+  {
+    UNVISITED,
+    OPEN,
+    CLOSED
+  };
+
+  /**
+   * Marks all cells as unvisited, memory is only reallocated if the number of cells changes
+   * @param nb_cells
+   */
+  void reset(size_t nb_cells)
+  {
+    nodes_.resize(nb_cells);
+    status_.assign(nb_cells, UNVISITED);
+    nb_closed_ = 0;
+  }
+
+  [[nodiscard]] inline size_t size() const
+  {
+    return nodes_.size();
+  }
+
+  [[nodiscard]] inline STATUS getStatus(size_t index) const
+  {
+    return status_[index];
+  }
+
+  /**
+   * Checks if the cell is part of the heuristic, indices out of the grid are allowed
+   * @param index
+   * @return
+   */
+  [[nodiscard]] inline bool contains(size_t index) const
+  {
+    return index < status_.size() && status_[index] == CLOSED;
+  }
+
+  [[nodiscard]] inline const NodeDisc& operator[](size_t index) const
+  {
+    return nodes_[index];
+  }
+
+  [[nodiscard]] const NodeDisc& at(size_t index) const
+  {
+    if (!contains(index))
+    {
+      throw std::out_of_range("Cell " + std::to_string(index) + " is not part of the heuristic");
+    }
+    return nodes_[index];
+  }
+
+  /**
+   * Adds a node to the open set or replaces the node of the cell, closed nodes are reopened
+   * @param index
+   * @param node
+   */
+  inline void open(size_t index, const NodeDisc& node)
+  {
+    if (status_[index] == CLOSED)
+    {
+      nb_closed_--;
+    }
+    nodes_[index] = node;
+    status_[index] = OPEN;
+  }
+
+  /**
+   * Removes a node from the open or closed set
+   * @param index
+   */
+  inline void unvisit(size_t index)
+  {
+    if (status_[index] == CLOSED)
+    {
+      nb_closed_--;
+    }
+    status_[index] = UNVISITED;
+  }
+
+  inline const NodeDisc& close(size_t index)
+  {
+    status_[index] = CLOSED;
+    nb_closed_++;
+    return nodes_[index];
+  }
+
+  [[nodiscard]] inline size_t nbClosed() const
+  {
+    return nb_closed_;
+  }
+
+  /**
+   * Returns the heuristic as map, only meant for the python side
+   * @return
+   */
+  [[nodiscard]] std::unordered_map<size_t, NodeDisc> getClosedMap() const
+  {
+    std::unordered_map<size_t, NodeDisc> closed_set;
+    closed_set.reserve(nb_closed_);
+    for (size_t index = 0; index < nodes_.size(); ++index)
+    {
+      if (status_[index] == CLOSED)
+      {
+        closed_set.emplace(index, nodes_[index]);
+      }
+    }
+    return closed_set;
+  }
+
+private:
+  std::vector<NodeDisc> nodes_;
+  std::vector<STATUS> status_;
+  size_t nb_closed_ = 0;
+};
+
+/**
+ * Flat copy of a node of the 2D search, element of the structured arrays of the heuristic for python
+ */
+struct NodeDiscRecord
+{
+  uint64_t index;
+  int32_t x;
+  int32_t y;
+  double cost;
+  int64_t parent;
+};
+
+/**
+ * Flat records that are handed out to python as views without copying them. The buffer is refilled in place unless a
+ * view still holds it, then a new one is allocated
+ * @tparam Record
+ */
+template <typename Record>
+class RecordBuffer
+{
+public:
+  std::vector<Record>& refill()
+  {
+    if (!records_ || records_.use_count() > 1)
+    {
+      records_ = std::make_shared<std::vector<Record>>();
+    }
+    records_->clear();
+    return *records_;
+  }
+
+  [[nodiscard]] std::shared_ptr<const std::vector<Record>> get() const
+  {
+    return records_;
+  }
+
+private:
+  std::shared_ptr<std::vector<Record>> records_;
+};
+
 enum PATH_TYPE
 {
   HASTAR,       // 0
@@ -72,8 +236,19 @@ enum PATH_TYPE
   UNKNOWN
 };
 
+/**
+ * Range of continuous poses of a node inside a TrajectoryArena
+ */
+struct TrajSegment
+{
+  uint32_t offset = 0;
+  uint32_t length = 0;
+};
+
 /**
  * Node of the Hybrid A* Algorithm that is used during exploration
+ * Nodes created during the search store their continuous poses as a segment in the trajectory arena of the search,
+ * only nodes created outside the search (e.g. from python) carry their own lists
  */
 class NodeHybrid
 {
@@ -107,7 +282,34 @@ public:
     , steer(steer_in)
     , parent_index(parent_index_in)
     , cost(cost_in)
-    , dist(dist_in){};
+    , dist(dist_in)
+  {
+    if (!x_list.empty())
+    {
+      pose = { x_list.back(), y_list.back(), yaw_list.back() };
+    }
+  };
+
+  NodeHybrid(int x_index_in,
+             int y_index_in,
+             int yaw_index_in,
+             int discrete_direction_in,
+             const TrajSegment& traj_in,
+             const Pose<double>& pose_in,
+             double steer_in,
+             int64_t parent_index_in,
+             double cost_in,
+             double dist_in)
+    : x_index(x_index_in)
+    , y_index(y_index_in)
+    , yaw_index(yaw_index_in)
+    , discrete_direction(discrete_direction_in)
+    , steer(steer_in)
+    , parent_index(parent_index_in)
+    , cost(cost_in)
+    , dist(dist_in)
+    , traj(traj_in)
+    , pose(pose_in){};
 
   void set_analytic()
   {
@@ -139,6 +341,24 @@ public:
   double cost = -1;
   double dist = 0;
   bool is_analytic = false;
+  // Poses of the node in the trajectory arena of the search
+  TrajSegment traj;
+  // Last continuous pose of the node
+  Pose<double> pose = { 0, 0, 0 };
+};
+
+/**
+ * Flat copy of a node of the hybrid search with its last pose, element of the structured arrays of the search sets
+ * for python
+ */
+struct NodeHybridRecord
+{
+  uint64_t index;
+  double x;
+  double y;
+  double yaw;
+  double cost;
+  int64_t parent;
 };
 
 class Segment
@@ -182,6 +402,8 @@ public:
   int idx_analytic = -1;
   std::vector<PATH_TYPE> types;
   bool is_emergency = false;
+  // Ends at the node closest to the goal because the search was stopped early
+  bool is_partial = false;
 
   // to sort paths
   [[nodiscard]] bool operator<(const Path& other) const
@@ -190,6 +412,137 @@ public:
   }
 };
 
+/**
+ * Bump allocator for the continuous poses of all nodes of a search, stored as struct of arrays.
+ * Nodes only keep a TrajSegment, the memory is kept between searches and released at once by reset()
+ */
+class TrajectoryArena
+{
+public:
+  void reset()
+  {
+    x_list_.clear();
+    y_list_.clear();
+    yaw_list_.clear();
+    dir_list_.clear();
+    types_.clear();
+  }
+
+  void reserve(size_t nb_elements)
+  {
+    x_list_.reserve(nb_elements);
+    y_list_.reserve(nb_elements);
+    yaw_list_.reserve(nb_elements);
+    dir_list_.reserve(nb_elements);
+    types_.reserve(nb_elements);
+  }
+
+  [[nodiscard]] inline size_t size() const
+  {
+    return x_list_.size();
+  }
+
+  /**
+   * Appends the poses of the lists starting at start_idx as a new segment with a single path type
+   * @param x_list
+   * @param y_list
+   * @param yaw_list
+   * @param dir_list
+   * @param type
+   * @param start_idx
+   * @return
+   */
+  TrajSegment append(const std::vector<double>& x_list,
+                     const std::vector<double>& y_list,
+                     const std::vector<double>& yaw_list,
+                     const std::vector<int>& dir_list,
+                     PATH_TYPE type,
+                     size_t start_idx = 0)
+  {
+    const TrajSegment segment = { static_cast<uint32_t>(size()),
+                                  static_cast<uint32_t>(x_list.size() - start_idx) };
+    x_list_.insert(x_list_.end(), x_list.begin() + start_idx, x_list.end());
+    y_list_.insert(y_list_.end(), y_list.begin() + start_idx, y_list.end());
+    yaw_list_.insert(yaw_list_.end(), yaw_list.begin() + start_idx, yaw_list.end());
+    dir_list_.insert(dir_list_.end(), dir_list.begin() + start_idx, dir_list.end());
+    types_.insert(types_.end(), segment.length, type);
+    return segment;
+  }
+
+  /**
+   * Appends the lists of a node that was created outside the search
+   * @param node
+   * @return
+   */
+  TrajSegment append(const NodeHybrid& node)
+  {
+    const TrajSegment segment = { static_cast<uint32_t>(size()), static_cast<uint32_t>(node.x_list.size()) };
+    x_list_.insert(x_list_.end(), node.x_list.begin(), node.x_list.end());
+    y_list_.insert(y_list_.end(), node.y_list.begin(), node.y_list.end());
+    yaw_list_.insert(yaw_list_.end(), node.yaw_list.begin(), node.yaw_list.end());
+    dir_list_.insert(dir_list_.end(), node.dir_list_cont.begin(), node.dir_list_cont.end());
+    types_.insert(types_.end(), node.types.begin(), node.types.end());
+    return segment;
+  }
+
+  /**
+   * Copies a segment of another arena to the end of this one
+   * @param other
+   * @param segment
+   * @return
+   */
+  TrajSegment append(const TrajectoryArena& other, const TrajSegment& segment)
+  {
+    const size_t start = segment.offset;
+    const size_t end = start + segment.length;
+    const TrajSegment new_segment = { static_cast<uint32_t>(size()), segment.length };
+    x_list_.insert(x_list_.end(), other.x_list_.begin() + start, other.x_list_.begin() + end);
+    y_list_.insert(y_list_.end(), other.y_list_.begin() + start, other.y_list_.begin() + end);
+    yaw_list_.insert(yaw_list_.end(), other.yaw_list_.begin() + start, other.yaw_list_.begin() + end);
+    dir_list_.insert(dir_list_.end(), other.dir_list_.begin() + start, other.dir_list_.begin() + end);
+    types_.insert(types_.end(), other.types_.begin() + start, other.types_.begin() + end);
+    return new_segment;
+  }
+
+  /**
+   * Appends the poses of a segment to the end of the path
+   * @param segment
+   * @param path
+   */
+  void extendPath(const TrajSegment& segment, Path& path) const
+  {
+    const size_t start = segment.offset;
+    const size_t end = start + segment.length;
+    path.x_list.insert(path.x_list.end(), x_list_.begin() + start, x_list_.begin() + end);
+    path.y_list.insert(path.y_list.end(), y_list_.begin() + start, y_list_.begin() + end);
+    path.yaw_list.insert(path.yaw_list.end(), yaw_list_.begin() + start, yaw_list_.begin() + end);
+    path.direction_list.insert(path.direction_list.end(), dir_list_.begin() + start, dir_list_.begin() + end);
+    path.types.insert(path.types.end(), types_.begin() + start, types_.begin() + end);
+  }
+
+  /**
+   * Fills the lists of the node with the poses of its segment
+   * @param node
+   */
+  void fillNodeLists(NodeHybrid& node) const
+  {
+    const size_t start = node.traj.offset;
+    const size_t end = start + node.traj.length;
+    node.x_list.assign(x_list_.begin() + start, x_list_.begin() + end);
+    node.y_list.assign(y_list_.begin() + start, y_list_.begin() + end);
+    node.yaw_list.assign(yaw_list_.begin() + start, yaw_list_.begin() + end);
+    node.dir_list_cont.assign(dir_list_.begin() + start, dir_list_.begin() + end);
+    node.types.assign(types_.begin() + start, types_.begin() + end);
+  }
+
+private:
+  std::vector<double> x_list_;
+  std::vector<double> y_list_;
+  std::vector<double> yaw_list_;
+  std::vector<int> dir_list_;
+  std::vector<PATH_TYPE> types_;
+};
+
 /**
  * Priority queue that drives the A* search, nodes are sorted by their estimated cost to the goal
  * This class sorts also the Hybrid Nodes
@@ -220,6 +573,409 @@ struct PriorityQueue
   }
 };
 
+/**
+ * Flat node storage of a search that is addressed directly by the unique index of a state.
+ * Open and closed set are a status per state, each node is stored only once and a new search invalidates all states
+ * in O(1) by increasing the generation counter
+ * @tparam T
+ */
+template <typename T>
+class NodePool
+{
+public:
+  enum STATUS : uint8_t
+  {
+    UNVISITED,
+    OPEN,
+    CLOSED
+  };
+
+  /**
+   * Sets the number of states, memory is only reallocated if it changes
+   * @param nb_states
+   */
+  void resize(size_t nb_states)
+  {
+    if (nb_states == generations_.size())
+    {
+      return;
+    }
+    generations_.assign(nb_states, 0);
+    status_.assign(nb_states, UNVISITED);
+    slots_.assign(nb_states, 0);
+    generation_ = 0;
+    reset();
+  }
+
+  /**
+   * Invalidates all states for a new search
+   */
+  void reset()
+  {
+    generation_++;
+    // generation counter overflowed, old stamps could become valid again
+    if (generation_ == 0)
+    {
+      std::fill(generations_.begin(), generations_.end(), 0);
+      generation_ = 1;
+    }
+    nodes_.clear();
+    node_indices_.clear();
+    nb_closed_ = 0;
+  }
+
+  [[nodiscard]] inline size_t nbStates() const
+  {
+    return generations_.size();
+  }
+
+  [[nodiscard]] inline STATUS getStatus(size_t index) const
+  {
+    return generations_[index] == generation_ ? status_[index] : UNVISITED;
+  }
+
+  [[nodiscard]] inline bool isOpen(size_t index) const
+  {
+    return getStatus(index) == OPEN;
+  }
+
+  [[nodiscard]] inline bool isClosed(size_t index) const
+  {
+    return getStatus(index) == CLOSED;
+  }
+
+  /**
+   * Adds a node of an unvisited state to the open set
+   * @param index
+   * @param node
+   * @return
+   */
+  T& insert(size_t index, T node)
+  {
+    generations_[index] = generation_;
+    status_[index] = OPEN;
+    slots_[index] = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back(std::move(node));
+    node_indices_.push_back(index);
+    return nodes_.back();
+  }
+
+  /**
+   * Replaces the node of an open state, e.g. after a cheaper one was found
+   * @param index
+   * @param node
+   */
+  void replace(size_t index, T node)
+  {
+    nodes_[slots_[index]] = std::move(node);
+  }
+
+  /**
+   * Moves an open state to the closed set
+   * @param index
+   * @return
+   */
+  T& close(size_t index)
+  {
+    status_[index] = CLOSED;
+    nb_closed_++;
+    return nodes_[slots_[index]];
+  }
+
+  /**
+   * Node of a visited state, references are invalidated by the next insert
+   * @param index
+   * @return
+   */
+  [[nodiscard]] const T& at(size_t index) const
+  {
+    if (index >= nbStates() || getStatus(index) == UNVISITED)
+    {
+      throw std::out_of_range("Node " + std::to_string(index) + " was not visited in the current search");
+    }
+    return nodes_[slots_[index]];
+  }
+
+  [[nodiscard]] inline size_t nbClosed() const
+  {
+    return nb_closed_;
+  }
+
+  [[nodiscard]] inline size_t nbOpen() const
+  {
+    return nodes_.size() - nb_closed_;
+  }
+
+  [[nodiscard]] inline bool empty() const
+  {
+    return nodes_.empty();
+  }
+
+  /**
+   * Calls func(index, node) for every node with the given status in insertion order
+   * @tparam F
+   * @param status
+   * @param func
+   */
+  template <typename F>
+  void forEach(STATUS status, F&& func) const
+  {
+    for (size_t slot = 0; slot < nodes_.size(); ++slot)
+    {
+      const size_t index = node_indices_[slot];
+      if (status_[index] == status)
+      {
+        func(index, nodes_[slot]);
+      }
+    }
+  }
+
+private:
+  // per state
+  std::vector<uint32_t> generations_;
+  std::vector<STATUS> status_;
+  std::vector<uint32_t> slots_;
+
+  // per visited state
+  std::vector<T> nodes_;
+  std::vector<size_t> node_indices_;
+
+  uint32_t generation_ = 0;
+  size_t nb_closed_ = 0;
+};
+
+/**
+ * d-ary min heap over the item indices [0, nb_items) with a position index per item.
+ * In contrast to PriorityQueue, putting an item that is already queued updates its priority (decrease-key) instead
+ * of adding a stale duplicate. Ties are resolved by the item index, like in PriorityQueue
+ * @tparam T unsigned index type
+ * @tparam priority_t
+ * @tparam ARITY number of children of each heap element
+ */
+template <typename T, typename priority_t, size_t ARITY = 4>
+class IndexedPriorityQueue
+{
+public:
+  using PqElement = std::pair<priority_t, T>;
+
+  /**
+   * Sets the number of items that can be queued and empties the queue
+   * @param nb_items
+   */
+  void resize(size_t nb_items)
+  {
+    if (nb_items == positions_.size())
+    {
+      clear();
+      return;
+    }
+    elements_.clear();
+    positions_.assign(nb_items, NOT_QUEUED);
+  }
+
+  /**
+   * Empties the queue in O(size)
+   */
+  void clear()
+  {
+    for (const auto& element : elements_)
+    {
+      positions_[element.second] = NOT_QUEUED;
+    }
+    elements_.clear();
+  }
+
+  [[nodiscard]] inline bool empty() const
+  {
+    return elements_.empty();
+  }
+
+  [[nodiscard]] inline size_t size() const
+  {
+    return elements_.size();
+  }
+
+  [[nodiscard]] inline bool contains(T item) const
+  {
+    return positions_[item] != NOT_QUEUED;
+  }
+
+  /**
+   * Inserts an item or updates its priority if it is already queued
+   * @param item
+   * @param priority
+   */
+  inline void put(T item, priority_t priority)
+  {
+    const uint32_t pos = positions_[item];
+    if (pos == NOT_QUEUED)
+    {
+      elements_.emplace_back(priority, item);
+      siftUp(elements_.size() - 1);
+      return;
+    }
+
+    const PqElement old_element = elements_[pos];
+    elements_[pos].first = priority;
+    if (elements_[pos] < old_element)
+    {
+      siftUp(pos);
+    }
+    else
+    {
+      siftDown(pos);
+    }
+  }
+
+  [[nodiscard]] inline priority_t topPriority() const
+  {
+    return elements_.front().first;
+  }
+
+  T get()
+  {
+    const T best_item = elements_.front().second;
+    positions_[best_item] = NOT_QUEUED;
+
+    elements_.front() = elements_.back();
+    elements_.pop_back();
+    if (!elements_.empty())
+    {
+      siftDown(0);
+    }
+    return best_item;
+  }
+
+private:
+  inline static constexpr uint32_t NOT_QUEUED = std::numeric_limits<uint32_t>::max();
+
+  std::vector<PqElement> elements_;
+  std::vector<uint32_t> positions_;
+
+  inline void place(size_t pos, const PqElement& element)
+  {
+    elements_[pos] = element;
+    positions_[element.second] = static_cast<uint32_t>(pos);
+  }
+
+  void siftUp(size_t pos)
+  {
+    const PqElement element = elements_[pos];
+    while (pos > 0)
+    {
+      const size_t parent = (pos - 1) / ARITY;
+      if (!(element < elements_[parent]))
+      {
+        break;
+      }
+      place(pos, elements_[parent]);
+      pos = parent;
+    }
+    place(pos, element);
+  }
+
+  void siftDown(size_t pos)
+  {
+    const PqElement element = elements_[pos];
+    const size_t nb_elements = elements_.size();
+    while (true)
+    {
+      const size_t first_child = pos * ARITY + 1;
+      if (first_child >= nb_elements)
+      {
+        break;
+      }
+
+      // smallest child
+      size_t best_child = first_child;
+      const size_t last_child = std::min(first_child + ARITY, nb_elements);
+      for (size_t child = first_child + 1; child < last_child; ++child)
+      {
+        if (elements_[child] < elements_[best_child])
+        {
+          best_child = child;
+        }
+      }
+
+      if (!(elements_[best_child] < element))
+      {
+        break;
+      }
+      place(pos, elements_[best_child]);
+      pos = best_child;
+    }
+    place(pos, element);
+  }
+};
+
+/**
+ * Monotone bucket queue (Dial) for non-negative priorities.
+ * Priorities are quantized to buckets of a fixed width and items of one bucket are taken in LIFO order, so the
+ * ordering error is bounded by the bucket width. A search that closes nodes in this order is therefore only
+ * approximate, unlike with PriorityQueue. Priorities below the current bucket are put into the current one.
+ * Like PriorityQueue, updated items are put again and stale entries must be skipped by the caller
+ * @tparam T
+ * @tparam priority_t
+ */
+template <typename T, typename priority_t>
+class BucketQueue
+{
+public:
+  /**
+   * Empties the queue, memory of the buckets is kept
+   * @param bucket_width
+   */
+  void reset(priority_t bucket_width)
+  {
+    for (size_t bucket = current_; bucket < buckets_.size(); ++bucket)
+    {
+      buckets_[bucket].clear();
+    }
+    bucket_width_inv_ = 1 / bucket_width;
+    current_ = 0;
+    size_ = 0;
+  }
+
+  [[nodiscard]] inline bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] inline size_t size() const
+  {
+    return size_;
+  }
+
+  inline void put(T item, priority_t priority)
+  {
+    const auto bucket = std::max(static_cast<size_t>(std::max(priority, priority_t(0)) * bucket_width_inv_), current_);
+    if (bucket >= buckets_.size())
+    {
+      buckets_.resize(bucket + 1);
+    }
+    buckets_[bucket].push_back(item);
+    size_++;
+  }
+
+  T get()
+  {
+    while (buckets_[current_].empty())
+    {
+      current_++;
+    }
+    const T best_item = buckets_[current_].back();
+    buckets_[current_].pop_back();
+    size_--;
+    return best_item;
+  }
+
+private:
+  std::vector<std::vector<T>> buckets_;
+  priority_t bucket_width_inv_ = 1;
+  size_t current_ = 0;
+  size_t size_ = 0;
+};
+
 class LaneNode
 {
 public:
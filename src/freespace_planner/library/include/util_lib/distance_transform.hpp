@@ -0,0 +1,36 @@
+#ifndef FREESPACE_PLANNER_DISTANCE_TRANSFORM_HPP
+#define FREESPACE_PLANNER_DISTANCE_TRANSFORM_HPP
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Exact Euclidean feature transform of a grid after Felzenszwalb and Huttenlocher.
+ * Delivers for every cell the squared distance to the nearest site and the flat index of that site in linear time,
+ * first along the columns, then as lower envelope of parabolas along the rows. The scratch buffers are kept between
+ * the calls, so every user owns its own instance
+ */
+class DistanceTransform
+{
+public:
+  inline static constexpr int NO_SITE = -1;
+
+  void execute(const std::vector<uint8_t>& is_site,
+               int x_dim,
+               int y_dim,
+               std::vector<double>& dist_sqr,
+               std::vector<int>& nearest);
+
+private:
+  std::vector<int> column_site_;
+  std::vector<double> row_cost_;
+  std::vector<int> row_site_;
+  std::vector<int> envelope_pos_;
+  std::vector<double> envelope_bounds_;
+
+  void transformColumns(const std::vector<uint8_t>& is_site, int x_dim, int y_dim);
+
+  void transformRow(int y_ind, int x_dim, std::vector<double>& dist_sqr, std::vector<int>& nearest);
+};
+
+#endif  // FREESPACE_PLANNER_DISTANCE_TRANSFORM_HPP
@@ -0,0 +1,36 @@
+#ifndef FREESPACE_PLANNER_MAX_POOL_CPU_HPP
+#define FREESPACE_PLANNER_MAX_POOL_CPU_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "util_lib/thread_pool.hpp"
+
+/**
+ * CPU max pooling with the same interface and the same results as the cuDNN pooling in cuda_lib.
+ * Square window with stride equal to the window size and without padding, the values are compared as int8 like in
+ * the cuDNN path. The rows are reduced elementwise first, which the compiler vectorizes, and the output rows can be
+ * distributed on multiple threads
+ */
+class PoolingCpu
+{
+public:
+  void init(int pooling_dim, size_t nb_threads = 1);
+
+  void execute(const uint8_t* image_pointer, uint8_t* result, int in_dim, int out_dim);
+
+private:
+  int pooling_dim_ = 1;
+  ThreadPool thread_pool_;
+  std::vector<std::vector<int8_t>> row_max_;
+
+  void poolRows(const uint8_t* image_pointer,
+                uint8_t* result,
+                int in_dim,
+                int out_dim,
+                int row_begin,
+                int row_end,
+                std::vector<int8_t>& row_max) const;
+};
+
+#endif  // FREESPACE_PLANNER_MAX_POOL_CPU_HPP
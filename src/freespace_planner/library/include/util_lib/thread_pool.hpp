@@ -0,0 +1,70 @@
+#ifndef FREESPACE_PLANNER_THREAD_POOL_HPP
+#define FREESPACE_PLANNER_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Persistent pool of worker threads for fork-join loops with many small tasks.
+ * The threads are kept alive between calls and spin shortly before they sleep, so the wake up latency stays small
+ * compared to the tasks of a single node expansion
+ */
+class ThreadPool
+{
+public:
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool();
+
+  /**
+   * Sets the number of threads including the calling one, 0 or 1 executes all tasks on the calling thread
+   * @param nb_threads
+   */
+  void resize(size_t nb_threads);
+
+  [[nodiscard]] size_t size() const
+  {
+    return workers_.size() + 1;
+  }
+
+  /**
+   * Calls func(task_idx) for all tasks and returns after all of them finished, the calling thread works as well.
+   * The first exception of a task is rethrown
+   * @param nb_tasks
+   * @param func
+   */
+  void parallelFor(size_t nb_tasks, const std::function<void(size_t)>& func);
+
+private:
+  inline static constexpr int NB_SPINS = 4000;
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+
+  const std::function<void(size_t)>* task_ = nullptr;
+  size_t nb_tasks_ = 0;
+  std::atomic<size_t> next_task_ = 0;
+  std::atomic<uint64_t> generation_ = 0;
+  size_t nb_busy_ = 0;
+  bool stop_ = false;
+  std::exception_ptr exception_;
+
+  void stop();
+
+  void workerLoop(uint64_t last_generation);
+
+  void runTasks();
+};
+
+#endif  // FREESPACE_PLANNER_THREAD_POOL_HPP
@@ -65,128 +65,131 @@ inline std::vector<T> transformVec(const std::vector<T>& vec, std::function<T(T)
   return vec_new;
 }
 
+/**
+ * Transforms between utm, patch utm, grid map and A* grid coordinates of one planning patch
+ */
 class grid_tf
 {
 public:
-  inline static double gm2con_;
-  inline static double con2gm_;
+  double gm2con_ = 0;
+  double con2gm_ = 0;
 
-  inline static double star2con_;
-  inline static double con2star_;
+  double star2con_ = 0;
+  double con2star_ = 0;
 
-  inline static double gm2star_;
-  inline static double star2gm_;
+  double gm2star_ = 0;
+  double star2gm_ = 0;
 
 private:
-  inline static Point<double> patch_origin_utm_;
+  Point<double> patch_origin_utm_;
 
 public:
-  static void updateTransforms(double gm_res, double astar_res, const Point<double>& patch_origin_utm);
+  void updateTransforms(double gm_res, double astar_res, const Point<double>& patch_origin_utm);
 
-  static void updateGmRes(double gm_res);
+  void updateGmRes(double gm_res);
 
-  static void updateAstarRes(double astar_res);
+  void updateAstarRes(double astar_res);
 
-  static void updatePatchOrigin(const Point<double>& patch_origin_utm);
+  void updatePatchOrigin(const Point<double>& patch_origin_utm);
 
   template <typename T>
-  static inline T utm2grid(const T& val)
+  inline T utm2grid(const T& val) const
   {
     return val * con2gm_;
   }
 
-  static inline int utm2grid_round(double val)
+  inline int utm2grid_round(double val) const
   {
     return static_cast<int>(std::round(val * con2gm_));
   }
 
-  static inline Point<int> utm2grid_round(const Point<double>& val)
+  inline Point<int> utm2grid_round(const Point<double>& val) const
   {
     return (val * con2gm_).toInt();
   }
 
-  static inline Pose<int> utm2grid_round(const Pose<double>& val)
+  inline Pose<int> utm2grid_round(const Pose<double>& val) const
   {
     return (val * con2gm_).toInt();
   }
 
   template <typename T>
-  static inline T grid2utm(const T& val)
+  inline T grid2utm(const T& val) const
   {
     return val * gm2con_;
   }
 
   template <typename T>
-  static inline T utm2astar(const T& val)
+  inline T utm2astar(const T& val) const
   {
     return val * con2star_;
   }
 
   template <typename T>
-  static inline T astar2utm(const T& val)
+  inline T astar2utm(const T& val) const
   {
     return val * star2con_;
   }
 
   template <typename T>
-  static inline T grid2astar(const T& val)
+  inline T grid2astar(const T& val) const
   {
     return val * gm2star_;
   }
 
   template <typename T>
-  static inline T astar2grid(const T& val)
+  inline T astar2grid(const T& val) const
   {
     return val * star2gm_;
   }
 
   /// utm 2 patch utm
   template <typename T>
-  static inline T utm2patch_utm_x(T val)
+  inline T utm2patch_utm_x(T val) const
   {
     return val - patch_origin_utm_.x;
   }
   template <typename T>
-  static inline T utm2patch_utm_y(T val)
+  inline T utm2patch_utm_y(T val) const
   {
     return val - patch_origin_utm_.y;
   }
-  static Pose<double> utm2patch_utm(const Pose<double>& pose);
+  Pose<double> utm2patch_utm(const Pose<double>& pose) const;
 
-  static Point<double> utm2patch_utm(const Point<double>& point);
+  Point<double> utm2patch_utm(const Point<double>& point) const;
 
-  static std::pair<std::vector<double>, std::vector<double>> utm2patch_utm(const std::vector<double>& x_vec,
-                                                                           const std::vector<double>& y_vec);
+  std::pair<std::vector<double>, std::vector<double>> utm2patch_utm(const std::vector<double>& x_vec,
+                                                                    const std::vector<double>& y_vec) const;
 
   /// Patch utm 2 utm
   template <typename T>
-  static inline T patch_utm2utm_x(T val)
+  inline T patch_utm2utm_x(T val) const
   {
     return val + patch_origin_utm_.x;
   }
   template <typename T>
-  static inline T patch_utm2utm_y(T val)
+  inline T patch_utm2utm_y(T val) const
   {
     return val + patch_origin_utm_.y;
   }
-  static Pose<double> patch_utm2utm(const Pose<double>& pose);
+  Pose<double> patch_utm2utm(const Pose<double>& pose) const;
 
-  static Point<double> patch_utm2utm(const Point<double>& point);
+  Point<double> patch_utm2utm(const Point<double>& point) const;
 
-  static std::pair<std::vector<double>, std::vector<double>> patch_utm2utm(const std::vector<double>& x_vec,
-                                                                           const std::vector<double>& y_vec);
+  std::pair<std::vector<double>, std::vector<double>> patch_utm2utm(const std::vector<double>& x_vec,
+                                                                    const std::vector<double>& y_vec) const;
 
-  static Path patch_utm2utm(const Path& path);
+  Path patch_utm2utm(const Path& path) const;
 
   /// Patch utm 2 global grid
-  static Pose<double> patch_utm2global_gm(const Pose<double>& pose);
+  Pose<double> patch_utm2global_gm(const Pose<double>& pose) const;
 
-  static Point<double> patch_utm2global_gm(const Point<double>& point);
+  Point<double> patch_utm2global_gm(const Point<double>& point) const;
 
-  static pair_of_vec<double> patch_utm2global_gm(const std::vector<double>& x_vec, const std::vector<double>& y_vec);
+  pair_of_vec<double> patch_utm2global_gm(const std::vector<double>& x_vec, const std::vector<double>& y_vec) const;
 
   /// Utm 2 grid
-  static pair_of_vec<double> utm2global_gm(const std::vector<double>& x_vec, const std::vector<double>& y_vec);
+  pair_of_vec<double> utm2global_gm(const std::vector<double>& x_vec, const std::vector<double>& y_vec) const;
 };
 
 #endif  // TRANSFORMS_HPP
@@ -35,6 +35,7 @@ void copyPatch2Patch(const Point<int>& prev_origin_grid,
                      Vec2DFlat<T>& arr,
                      Vec2DFlat<T> temp_arr)
 {
+  arr.unshare();
   const auto [prev_dim, unused1] = temp_arr.getDims();
   const auto [next_dim, unused2] = arr.getDims();
 
@@ -596,13 +596,9 @@ class Vis:
                     cmap = matplotlib.cm.get_cmap('jet_r')
                     heur_map_gray = -np.ones((HybridAStar.astar_dim_, HybridAStar.astar_dim_), dtype=np.float64)
 
-                    # TODO (Schumann) do all this in cpp
-                    h_dp_global = AStar.getDistanceHeuristic(False)
+                    h_dp_global = AStar.getDistanceHeuristicNodes(False)
                     # self.logger.log_debug("Number of visited nodes", len(h_dp_global))
-                    if h_dp_global is not None:
-                        for obj in h_dp_global:
-                            el = obj[1]
-                            heur_map_gray[el.pos.y, el.pos.x] = el.cost_
+                    heur_map_gray[h_dp_global["y"], h_dp_global["x"]] = h_dp_global["cost"]
 
                     # normalise
                     max_val = np.max(heur_map_gray)
@@ -0,0 +1,122 @@
+#include "benchmark_environment.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+/**
+ * Initializes the modules with the changed config and passes a map with random boxes
+ * @param config_changes keys of the config and their new values
+ * @param seed of the obstacles
+ */
+BenchmarkEnvironment::BenchmarkEnvironment(const ConfigChanges& config_changes, unsigned int seed)
+  : collision_checker_(vehicle_, grid_tf_), astar_(collision_checker_, grid_tf_)
+{
+  const std::string path2config = writeConfig(config_changes);
+  const YAML::Node config = YAML::LoadFile(path2config);
+  const int patch_dim = config["GM_DIM"].as<int>();
+  const Point<double> patch_origin_utm(0, 0);
+
+  // Default vehicle of the python planner
+  vehicle_.initialize(0.55, 2.7, 3.0, 1.0, 2.0, config["IS_USHIFT"].as<bool>());
+  grid_tf_.updateTransforms(config["GM_RES"].as<double>(), config["PLANNER_RES"].as<double>(), patch_origin_utm);
+  astar_.initialize(patch_dim, patch_origin_utm, path2config);
+  collision_checker_.initialize(patch_dim, path2config);
+  std::filesystem::remove(path2config);
+
+  // Costs of the 2D search, set by python otherwise
+  astar_.alpha_ = config["alpha_"].as<double>();
+  astar_.do_max_ = config["do_max_"].as<double>();
+  astar_.do_min_ = config["do_min_"].as<double>();
+  astar_.astar_prox_cost_ = config["astar_prox_cost_"].as<double>();
+  astar_.astar_movement_cost_ = config["astar_movement_cost_"].as<double>();
+  astar_.astar_lane_movement_cost_ = config["astar_lane_movement_cost_"].as<double>();
+  astar_.resetMovementMap();
+
+  const int margin = astar_.astar_dim_ / 10;
+  ego_index_ = { margin, margin };
+  goal_index_ = { astar_.astar_dim_ - 1 - margin, astar_.astar_dim_ - 1 - margin };
+
+  passRandomMap(patch_dim, seed);
+}
+
+/**
+ * Planner grid and Voronoi potential field like HybridAStar::recalculateEnv
+ */
+void BenchmarkEnvironment::recalculateEnv()
+{
+  astar_.calcAstarGrid();
+  astar_.calcVoronoiPotentialField(ego_index_);
+}
+
+/**
+ * Copy of the config of the library with changed entries in the temp directory
+ * @param config_changes
+ * @return path of the copy
+ */
+std::string BenchmarkEnvironment::writeConfig(const ConfigChanges& config_changes)
+{
+  YAML::Node config = YAML::LoadFile(FREESPACE_PLANNER_CONFIG);
+  for (const auto& [key, value] : config_changes)
+  {
+    config[key] = value;
+  }
+
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "freespace_planner_benchmark.yml";
+  std::ofstream config_file(path);
+  config_file << config;
+  return path.string();
+}
+
+/**
+ * Free patch with a border and random boxes, the corners of the ego vehicle and the goal are kept free
+ * @param patch_dim
+ * @param seed
+ */
+void BenchmarkEnvironment::passRandomMap(int patch_dim, unsigned int seed)
+{
+  constexpr int NB_BOXES = 60;
+  constexpr int BORDER = 5;
+  // Occupancy values, they are classified with MIN_THRESH and MAX_THRESH
+  constexpr uint8_t FREE_VALUE = 0;
+  constexpr uint8_t OCC_VALUE = 255;
+  Vec2DFlat<uint8_t> map;
+  map.resize_and_reset(patch_dim, patch_dim, FREE_VALUE);
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int> position_distribution(0, patch_dim - 1);
+  std::uniform_int_distribution<int> size_distribution(5, patch_dim / 10);
+  const int free_corner = patch_dim / 5;
+  for (int box = 0; box < NB_BOXES; ++box)
+  {
+    const int x_start = position_distribution(generator);
+    const int y_start = position_distribution(generator);
+    const int x_end = std::min(x_start + size_distribution(generator), patch_dim);
+    const int y_end = std::min(y_start + size_distribution(generator), patch_dim);
+    for (int y_index = y_start; y_index < y_end; ++y_index)
+    {
+      for (int x_index = x_start; x_index < x_end; ++x_index)
+      {
+        const bool near_ego = x_index < free_corner && y_index < free_corner;
+        const bool near_goal = x_index >= patch_dim - free_corner && y_index >= patch_dim - free_corner;
+        if (!near_ego && !near_goal)
+        {
+          map(y_index, x_index) = OCC_VALUE;
+        }
+      }
+    }
+  }
+  for (int index = 0; index < patch_dim; ++index)
+  {
+    for (int border = 0; border < BORDER; ++border)
+    {
+      map(index, border) = OCC_VALUE;
+      map(index, patch_dim - 1 - border) = OCC_VALUE;
+      map(border, index) = OCC_VALUE;
+      map(patch_dim - 1 - border, index) = OCC_VALUE;
+    }
+  }
+
+  collision_checker_.passLocalMap(map, Point<int>(0, 0), patch_dim);
+  collision_checker_.processSafetyPatch();
+}
@@ -0,0 +1,46 @@
+#ifndef FREESPACE_PLANNER_BENCHMARK_ENVIRONMENT_HPP
+#define FREESPACE_PLANNER_BENCHMARK_ENVIRONMENT_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util_lib/transforms.hpp"
+
+#include "collision_checker_lib/collision_checking.hpp"
+#include "collision_checker_lib/vehicle.hpp"
+
+#include "hybridastar_planning_lib/a_star.hpp"
+
+/**
+ * Modules of the 2D search on a patch with random obstacles. They are initialized like by the planner from the config
+ * of the library, single entries of the config can be changed to compare the backends
+ */
+class BenchmarkEnvironment
+{
+public:
+  using ConfigChanges = std::vector<std::pair<std::string, std::string>>;
+
+  // The modules are constructed in this order, every module only references the ones above it
+  Vehicle vehicle_;
+  grid_tf grid_tf_;
+  CollisionChecker collision_checker_;
+  AStar astar_;
+
+  // Cells of the planner grid in opposite corners of the patch
+  Point<int> ego_index_;
+  Point<int> goal_index_;
+
+  explicit BenchmarkEnvironment(const ConfigChanges& config_changes = {}, unsigned int seed = 42);
+  BenchmarkEnvironment(const BenchmarkEnvironment&) = delete;
+  BenchmarkEnvironment& operator=(const BenchmarkEnvironment&) = delete;
+
+  void recalculateEnv();
+
+private:
+  static std::string writeConfig(const ConfigChanges& config_changes);
+
+  void passRandomMap(int patch_dim, unsigned int seed);
+};
+
+#endif  // FREESPACE_PLANNER_BENCHMARK_ENVIRONMENT_HPP
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.hpp"
+
+/**
+ * Benchmarks of the planner backends against their alternatives, built with BUILD_BENCHMARKS. Runs all benchmarks or
+ * the ones given by name
+ */
+int main(int argc, char** argv)
+{
+  const std::vector<std::pair<const char*, void (*)()>> benchmarks = {
+    { "priority_queue", &benchmarkPriorityQueues },
+    { "heuristic_queue", &benchmarkHeuristicQueues },
+    { "pooling", &benchmarkPooling },
+    { "voronoi", &benchmarkVoronoiBackends },
+    { "voronoi_tiles", &benchmarkVoronoiTiles },
+    { "nonh_table", &benchmarkNonhTable },
+  };
+
+  const auto is_known = [&](const char* arg) {
+    return std::any_of(benchmarks.begin(), benchmarks.end(), [arg](const auto& benchmark) {
+      return std::strcmp(benchmark.first, arg) == 0;
+    });
+  };
+  if (!std::all_of(argv + 1, argv + argc, is_known))
+  {
+    std::printf("Available benchmarks:");
+    for (const auto& benchmark : benchmarks)
+    {
+      std::printf(" %s", benchmark.first);
+    }
+    std::printf("\n");
+    return 1;
+  }
+
+  for (const auto& [name, benchmark] : benchmarks)
+  {
+    const char* benchmark_name = name;
+    if (argc == 1 ||
+        std::any_of(argv + 1, argv + argc, [&](const char* arg) { return std::strcmp(benchmark_name, arg) == 0; }))
+    {
+      std::printf("--- %s\n", name);
+      benchmark();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef FREESPACE_PLANNER_BENCHMARKS_HPP
+#define FREESPACE_PLANNER_BENCHMARKS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+// Edge length of the patch the planner uses by default
+inline constexpr int BENCHMARK_DIM = 801;
+
+/**
+ * Runs a function several times, the fastest run is the least disturbed one
+ * @tparam Func
+ * @param func
+ * @param nb_runs
+ * @return duration of the fastest run in ms
+ */
+template <typename Func>
+double measureMs(Func&& func, int nb_runs)
+{
+  double best_ms = std::numeric_limits<double>::max();
+  for (int run = 0; run < nb_runs; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+    best_ms = std::min(best_ms, duration.count());
+  }
+  return best_ms;
+}
+
+// Every benchmark prints its results
+void benchmarkPriorityQueues();
+void benchmarkHeuristicQueues();
+void benchmarkPooling();
+void benchmarkVoronoiBackends();
+void benchmarkVoronoiTiles();
+void benchmarkNonhTable();
+
+#endif  // FREESPACE_PLANNER_BENCHMARKS_HPP
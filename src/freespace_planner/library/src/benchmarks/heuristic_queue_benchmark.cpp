@@ -0,0 +1,96 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark_environment.hpp"
+#include "benchmarks.hpp"
+
+namespace
+{
+constexpr int NB_RUNS = 20;
+
+/**
+ * Guidance heuristic from the goal to the ego vehicle with the frontier of the config changes
+ * @param env
+ * @param costs of the cells, negative if the heuristic does not contain the cell
+ * @return fastest run in ms
+ */
+double measureGuidanceHeuristic(BenchmarkEnvironment& env, std::vector<double>& costs)
+{
+  env.recalculateEnv();
+  const double duration_ms =
+      measureMs([&]() { env.astar_.calcDistanceHeuristic(env.goal_index_, env.ego_index_, false); }, NB_RUNS);
+
+  const NodeDiscGrid& heuristic = env.astar_.closed_set_guidance_;
+  costs.assign(heuristic.size(), -1);
+  for (size_t index = 0; index < heuristic.size(); ++index)
+  {
+    if (heuristic.contains(index))
+    {
+      costs[index] = heuristic[index].cost_;
+    }
+  }
+  return duration_ms;
+}
+}  // namespace
+
+/**
+ * Frontier of the guidance heuristic: the exact binary heap against the approximate bucket queue for several
+ * HEURISTIC_BUCKET_WIDTH. The bucket queue expands the nodes of a bucket in any order, the deviation of its costs from
+ * the exact ones is reported for the cells both heuristics contain
+ */
+void benchmarkHeuristicQueues()
+{
+  const double config_width = YAML::LoadFile(FREESPACE_PLANNER_CONFIG)["HEURISTIC_BUCKET_WIDTH"].as<double>();
+  const BenchmarkEnvironment::ConfigChanges heap_config = { { "HEURISTIC_QUEUE", "0" },
+                                                            { "HEURISTIC_INCREMENTAL", "False" } };
+
+  std::vector<double> exact_costs;
+  BenchmarkEnvironment heap_env(heap_config);
+  const double heap_ms = measureGuidanceHeuristic(heap_env, exact_costs);
+  std::printf("Guidance heuristic on a %dx%d patch (%dx%d planner cells), fastest of %d runs\n",
+              BENCHMARK_DIM,
+              BENCHMARK_DIM,
+              heap_env.astar_.astar_dim_,
+              heap_env.astar_.astar_dim_,
+              NB_RUNS);
+  std::printf("  binary heap              %7.2f ms\n", heap_ms);
+
+  std::vector<double> bucket_costs;
+  for (const double width : { 0.1, 0.25, 0.5, 1.0, 2.0 })
+  {
+    BenchmarkEnvironment bucket_env({ { "HEURISTIC_QUEUE", "1" },
+                                      { "HEURISTIC_BUCKET_WIDTH", std::to_string(width) },
+                                      { "HEURISTIC_INCREMENTAL", "False" } });
+    const double bucket_ms = measureGuidanceHeuristic(bucket_env, bucket_costs);
+
+    size_t nb_cells = 0;
+    size_t nb_deviating = 0;
+    double max_deviation = 0;
+    double sum_rel_deviation = 0;
+    for (size_t index = 0; index < exact_costs.size(); ++index)
+    {
+      if (exact_costs[index] < 0 || bucket_costs[index] < 0)
+      {
+        continue;
+      }
+      const double deviation = std::abs(bucket_costs[index] - exact_costs[index]);
+      nb_cells++;
+      nb_deviating += deviation > 1e-9 ? 1 : 0;
+      max_deviation = std::max(max_deviation, deviation);
+      sum_rel_deviation += exact_costs[index] > 0 ? deviation / exact_costs[index] : 0;
+    }
+
+    std::printf("  bucket queue, width %4.2f %7.2f ms, speedup %.2f, %5.1f %% of %zu cells deviate, max %.3f, "
+                "mean %.4f %%%s\n",
+                width,
+                bucket_ms,
+                heap_ms / bucket_ms,
+                100.0 * static_cast<double>(nb_deviating) / static_cast<double>(std::max(nb_cells, size_t(1))),
+                nb_cells,
+                max_deviation,
+                100.0 * sum_rel_deviation / static_cast<double>(std::max(nb_cells, size_t(1))),
+                std::abs(width - config_width) < 1e-9 ? " (config)" : "");
+  }
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+#include "hybridastar_planning_lib/nonh_table.hpp"
+
+#include "benchmarks.hpp"
+
+namespace
+{
+constexpr int NB_RUNS = 10;
+constexpr size_t NB_LOOKUPS = size_t(1) << 21;
+
+struct Lookup
+{
+  int yaw_idx;
+  int y_ind;
+  int x_ind;
+};
+
+/**
+ * Stand-in for the Reeds-Shepp distance to the goal at the patch center, with the same symmetries. Mirroring the start
+ * at an axis through the goal negates the yaw, which does not change the cosine
+ * @param yaw_dim
+ * @param patch_dim
+ * @return
+ */
+NonhTable::RowGenerator symmetricRowGenerator(int yaw_dim, int patch_dim)
+{
+  const int center = (patch_dim - 1) / 2;
+  return [yaw_dim, center](int yaw_idx, int y_ind, int x_ind, std::span<float> values) {
+    const double yaw = -M_PI + 2 * M_PI * yaw_idx / yaw_dim;
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+      const double x_dist = x_ind + static_cast<int>(index) - center;
+      const double y_dist = y_ind - center;
+      values[index] = static_cast<float>(std::hypot(x_dist, y_dist) * (1.5 - 0.5 * std::cos(yaw)) +
+                                         0.1 * std::abs(x_dist * std::sin(yaw)));
+    }
+  };
+}
+
+/**
+ * Generates the table into the temp directory and maps it like the planner does
+ * @param table
+ * @param yaw_dim
+ * @param patch_dim
+ * @param value_type
+ * @param layout
+ */
+void createTable(
+    NonhTable& table, int yaw_dim, int patch_dim, NonhTable::ValueType value_type, NonhTable::Layout layout)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / "freespace_planner_benchmark_nonh.bin").string();
+  const uint64_t key = NonhTable::hashKey({ static_cast<double>(yaw_dim),
+                                            static_cast<double>(patch_dim),
+                                            static_cast<double>(value_type),
+                                            static_cast<double>(layout) });
+  table.generate(path,
+                 key,
+                 yaw_dim,
+                 patch_dim,
+                 value_type,
+                 layout,
+                 std::max(std::thread::hardware_concurrency(), 1U),
+                 symmetricRowGenerator(yaw_dim, patch_dim));
+  table.load(path, key, yaw_dim, patch_dim, value_type, layout);
+  std::filesystem::remove(path);
+}
+
+/**
+ * Sum of the looked up values, which keeps the lookups from being optimized away
+ * @param table
+ * @param lookups
+ * @return
+ */
+double sumLookups(const NonhTable& table, const std::vector<Lookup>& lookups)
+{
+  double sum = 0;
+  for (const Lookup& lookup : lookups)
+  {
+    sum += table(lookup.yaw_idx, lookup.y_ind, lookup.x_ind);
+  }
+  return sum;
+}
+}  // namespace
+
+/**
+ * Random lookups of the non-holonomic heuristic with the full and the symmetric layout of the table. The symmetric
+ * layout needs a quarter of the memory but mirrors the indices on every lookup. Its values must be identical to the
+ * ones of the full layout
+ */
+void benchmarkNonhTable()
+{
+  const YAML::Node config = YAML::LoadFile(FREESPACE_PLANNER_CONFIG);
+  const int yaw_dim = 360 / config["YAW_RES"].as<int>();
+  const int config_patch_dim = config["NON_H_NO_OBS_PATCH_DIM"].as<int>();
+
+  std::printf("Non-holonomic heuristic table with %d yaw slices, %zu random lookups, fastest of %d runs\n",
+              yaw_dim,
+              NB_LOOKUPS,
+              NB_RUNS);
+  for (const int patch_dim : { config_patch_dim, 3 * config_patch_dim })
+  {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> yaw_distribution(0, yaw_dim - 1);
+    std::uniform_int_distribution<int> pos_distribution(0, patch_dim - 1);
+    std::vector<Lookup> lookups(NB_LOOKUPS);
+    for (Lookup& lookup : lookups)
+    {
+      lookup = { yaw_distribution(generator), pos_distribution(generator), pos_distribution(generator) };
+    }
+
+    for (const auto value_type : { NonhTable::FLOAT32, NonhTable::FLOAT16 })
+    {
+      NonhTable full_table;
+      NonhTable symmetric_table;
+      createTable(full_table, yaw_dim, patch_dim, value_type, NonhTable::FULL);
+      createTable(symmetric_table, yaw_dim, patch_dim, value_type, NonhTable::SYMMETRIC);
+
+      size_t nb_differing = 0;
+      for (int yaw_idx = 0; yaw_idx < yaw_dim; ++yaw_idx)
+      {
+        for (int y_ind = 0; y_ind < patch_dim; ++y_ind)
+        {
+          for (int x_ind = 0; x_ind < patch_dim; ++x_ind)
+          {
+            nb_differing += full_table(yaw_idx, y_ind, x_ind) != symmetric_table(yaw_idx, y_ind, x_ind) ? 1 : 0;
+          }
+        }
+      }
+
+      double full_sum = 0;
+      double symmetric_sum = 0;
+      const double full_ms = measureMs([&]() { full_sum = sumLookups(full_table, lookups); }, NB_RUNS);
+      const double symmetric_ms = measureMs([&]() { symmetric_sum = sumLookups(symmetric_table, lookups); }, NB_RUNS);
+
+      const double lookups_per_ms = static_cast<double>(NB_LOOKUPS) / 1e3;
+      std::printf("  %3d cells, %s: full %6.2f MB %6.1f M/s, symmetric %6.2f MB %6.1f M/s, %zu values differ%s\n",
+                  patch_dim,
+                  value_type == NonhTable::FLOAT16 ? "float16" : "float32",
+                  static_cast<double>(full_table.getSizeBytes()) / 1e6,
+                  lookups_per_ms / full_ms,
+                  static_cast<double>(symmetric_table.getSizeBytes()) / 1e6,
+                  lookups_per_ms / symmetric_ms,
+                  nb_differing,
+                  full_sum == symmetric_sum ? "" : ", sums differ");
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "util_lib/max_pool_cpu.hpp"
+
+#include "benchmarks.hpp"
+
+namespace
+{
+constexpr int NB_RUNS = 20;
+
+/**
+ * Max pooling cell by cell, values are compared as int8 like by cuDNN
+ * @param image
+ * @param result
+ * @param in_dim
+ * @param out_dim
+ * @param window
+ */
+void maxPoolReference(
+    const std::vector<uint8_t>& image, std::vector<uint8_t>& result, int in_dim, int out_dim, int window)
+{
+  result.assign(static_cast<size_t>(out_dim) * out_dim, 0);
+  for (int out_y = 0; out_y < out_dim; ++out_y)
+  {
+    for (int out_x = 0; out_x < out_dim; ++out_x)
+    {
+      int8_t maximum = std::numeric_limits<int8_t>::min();
+      for (int in_y = out_y * window; in_y < std::min((out_y + 1) * window, in_dim); ++in_y)
+      {
+        for (int in_x = out_x * window; in_x < std::min((out_x + 1) * window, in_dim); ++in_x)
+        {
+          maximum = std::max(maximum, static_cast<int8_t>(image[static_cast<size_t>(in_y) * in_dim + in_x]));
+        }
+      }
+      result[static_cast<size_t>(out_y) * out_dim + out_x] = static_cast<uint8_t>(maximum);
+    }
+  }
+}
+}  // namespace
+
+/**
+ * CPU pooling of the planner grid against a scalar reference, the results must be bit identical. Random bytes cover
+ * the int8 comparison, the occupancy classes are what the planner pools
+ */
+void benchmarkPooling()
+{
+  const int in_dim = BENCHMARK_DIM;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> byte_distribution(0, 255);
+  std::uniform_int_distribution<int> class_distribution(0, 2);
+  std::vector<uint8_t> random_bytes(static_cast<size_t>(in_dim) * in_dim);
+  std::vector<uint8_t> random_classes(random_bytes.size());
+  for (size_t index = 0; index < random_bytes.size(); ++index)
+  {
+    random_bytes[index] = static_cast<uint8_t>(byte_distribution(generator));
+    random_classes[index] = static_cast<uint8_t>(class_distribution(generator));
+  }
+
+  std::printf("Max pooling of a %dx%d patch, fastest of %d runs\n", in_dim, in_dim, NB_RUNS);
+  std::vector<uint8_t> expected;
+  std::vector<uint8_t> result;
+  bool all_identical = true;
+  for (const int window : { 2, 4, 5 })
+  {
+    const int out_dim = in_dim / window;
+    for (const size_t nb_threads : { size_t(1), size_t(4) })
+    {
+      PoolingCpu pooling;
+      pooling.init(window, nb_threads);
+      result.assign(static_cast<size_t>(out_dim) * out_dim, 0);
+
+      bool is_identical = true;
+      for (const std::vector<uint8_t>* image : { &random_bytes, &random_classes })
+      {
+        maxPoolReference(*image, expected, in_dim, out_dim, window);
+        pooling.execute(image->data(), result.data(), in_dim, out_dim);
+        is_identical = is_identical && result == expected;
+      }
+      all_identical = all_identical && is_identical;
+
+      const double reference_ms =
+          measureMs([&]() { maxPoolReference(random_classes, expected, in_dim, out_dim, window); }, NB_RUNS);
+      const double pooling_ms =
+          measureMs([&]() { pooling.execute(random_classes.data(), result.data(), in_dim, out_dim); }, NB_RUNS);
+      std::printf("  window %d, %zu threads: reference %6.3f ms, PoolingCpu %6.3f ms, speedup %5.2f, identical %s\n",
+                  window,
+                  nb_threads,
+                  reference_ms,
+                  pooling_ms,
+                  reference_ms / pooling_ms,
+                  is_identical ? "yes" : "no");
+    }
+  }
+  std::printf("  all identical %s\n", all_identical ? "yes" : "no");
+}
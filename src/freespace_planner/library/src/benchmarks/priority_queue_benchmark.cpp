@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "util_lib/data_structures2.hpp"
+
+#include "benchmarks.hpp"
+
+namespace
+{
+constexpr int NB_RUNS = 5;
+constexpr double UNREACHED = std::numeric_limits<double>::max();
+
+/**
+ * Dijkstra on an 8-connected grid, the queue is addressed by the cell index. Both queues resolve ties by the index,
+ * so they close the cells in the same order
+ * @tparam Queue
+ * @param cell_costs
+ * @param dim
+ * @param queue
+ * @param distances
+ * @return number of put calls
+ */
+template <typename Queue, bool IS_LAZY>
+size_t dijkstra(const std::vector<double>& cell_costs, int dim, Queue& queue, std::vector<double>& distances)
+{
+  distances.assign(cell_costs.size(), UNREACHED);
+  std::vector<bool> closed(cell_costs.size(), false);
+  const size_t start = static_cast<size_t>(dim / 2) * dim + dim / 2;
+  distances[start] = 0;
+  queue.put(start, 0);
+  size_t nb_puts = 1;
+
+  while (!queue.empty())
+  {
+    const size_t index = queue.get();
+    if constexpr (IS_LAZY)
+    {
+      // stale duplicate of a cell whose cost was lowered
+      if (closed[index])
+      {
+        continue;
+      }
+    }
+    closed[index] = true;
+
+    const int x_index = static_cast<int>(index % dim);
+    const int y_index = static_cast<int>(index / dim);
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+      for (int dx = -1; dx <= 1; ++dx)
+      {
+        const int x_next = x_index + dx;
+        const int y_next = y_index + dy;
+        if ((dx == 0 && dy == 0) || x_next < 0 || y_next < 0 || x_next >= dim || y_next >= dim)
+        {
+          continue;
+        }
+        const size_t next = static_cast<size_t>(y_next) * dim + x_next;
+        const double cost = distances[index] + cell_costs[next] * ((dx != 0 && dy != 0) ? std::sqrt(2.0) : 1.0);
+        if (!closed[next] && cost < distances[next])
+        {
+          distances[next] = cost;
+          queue.put(next, cost);
+          nb_puts++;
+        }
+      }
+    }
+  }
+  return nb_puts;
+}
+}  // namespace
+
+/**
+ * Open list of the searches: IndexedPriorityQueue with decrease-key against the lazy PriorityQueue that puts
+ * duplicates and skips the stale ones. Dijkstra over the full patch with random cell costs
+ */
+void benchmarkPriorityQueues()
+{
+  const int dim = BENCHMARK_DIM;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> cost_distribution(1.0, 10.0);
+  std::vector<double> cell_costs(static_cast<size_t>(dim) * dim);
+  for (double& cost : cell_costs)
+  {
+    cost = cost_distribution(generator);
+  }
+
+  std::vector<double> lazy_distances;
+  size_t lazy_puts = 0;
+  const double lazy_ms = measureMs(
+      [&]() {
+        PriorityQueue<size_t, double> queue;
+        lazy_puts = dijkstra<PriorityQueue<size_t, double>, true>(cell_costs, dim, queue, lazy_distances);
+      },
+      NB_RUNS);
+
+  std::vector<double> indexed_distances;
+  size_t indexed_puts = 0;
+  IndexedPriorityQueue<size_t, double> indexed_queue;
+  const double indexed_ms = measureMs(
+      [&]() {
+        indexed_queue.resize(cell_costs.size());
+        indexed_puts =
+            dijkstra<IndexedPriorityQueue<size_t, double>, false>(cell_costs, dim, indexed_queue, indexed_distances);
+      },
+      NB_RUNS);
+
+  const bool is_equal = lazy_distances == indexed_distances && lazy_puts == indexed_puts;
+  std::printf("Dijkstra on %dx%d cells, %zu puts, %zu of them are stale entries in the lazy queue\n",
+              dim,
+              dim,
+              lazy_puts,
+              lazy_puts - cell_costs.size());
+  std::printf("  PriorityQueue (lazy)          %8.1f ms\n", lazy_ms);
+  std::printf("  IndexedPriorityQueue (4-ary)  %8.1f ms\n", indexed_ms);
+  std::printf("  speedup %.2f, equal distances %s, fastest of %d runs\n",
+              lazy_ms / indexed_ms,
+              is_equal ? "yes" : "no",
+              NB_RUNS);
+}
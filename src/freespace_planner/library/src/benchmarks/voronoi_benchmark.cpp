@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "benchmark_environment.hpp"
+#include "benchmarks.hpp"
+
+namespace
+{
+constexpr int NB_RUNS = 10;
+
+// Window around the ego vehicle the Fortune backend calculates, AStar::VOR_DIM
+constexpr int FORTUNE_DIM = 150;
+
+// Cycles of the tiled EDT backend, each changes a few random boxes of the planner grid
+constexpr int NB_CYCLES = 20;
+constexpr int NB_CHANGES = 3;
+
+// Tiles only see Voronoi edges within their padded window
+constexpr double TILE_H_PROX_TOLERANCE = 0.02;
+
+// The EDT backend measures the distance to the Voronoi edges instead of to the vertices of the clipped edges
+constexpr double FORTUNE_H_PROX_TOLERANCE = 0.1;
+
+/**
+ * Deviation of two Voronoi potential fields within a window of the planner grid
+ */
+struct FieldDeviation
+{
+  double tolerance = 0;
+  size_t nb_cells = 0;
+  size_t nb_nonzero = 0;
+  size_t nb_exceeding = 0;
+  double max_h_prox = 0;
+  double mean_h_prox = 0;
+  double max_motion_res = 0;
+};
+
+/**
+ * Compares the proximity heuristic and the motion res map of two environments cell by cell. The cells above the
+ * tolerance are counted among the ones with a non-zero proximity heuristic in either environment
+ * @param env
+ * @param ref_env
+ * @param window_min
+ * @param window_max exclusive
+ * @param tolerance of the proximity heuristic
+ * @return
+ */
+FieldDeviation compareFields(const BenchmarkEnvironment& env,
+                             const BenchmarkEnvironment& ref_env,
+                             const Point<int>& window_min,
+                             const Point<int>& window_max,
+                             double tolerance)
+{
+  FieldDeviation deviation;
+  deviation.tolerance = tolerance;
+  double sum_h_prox = 0;
+  for (int y_ind = window_min.y; y_ind < window_max.y; ++y_ind)
+  {
+    for (int x_ind = window_min.x; x_ind < window_max.x; ++x_ind)
+    {
+      const double value = env.astar_.h_prox_arr_(y_ind, x_ind);
+      const double ref_value = ref_env.astar_.h_prox_arr_(y_ind, x_ind);
+      const double h_prox = std::abs(value - ref_value);
+      const double motion_res =
+          std::abs(env.astar_.motion_res_map_(y_ind, x_ind) - ref_env.astar_.motion_res_map_(y_ind, x_ind));
+      deviation.nb_cells++;
+      deviation.nb_nonzero += value != 0 || ref_value != 0 ? 1 : 0;
+      deviation.nb_exceeding += h_prox > tolerance ? 1 : 0;
+      deviation.max_h_prox = std::max(deviation.max_h_prox, h_prox);
+      deviation.max_motion_res = std::max(deviation.max_motion_res, motion_res);
+      sum_h_prox += h_prox;
+    }
+  }
+  deviation.mean_h_prox = sum_h_prox / static_cast<double>(std::max(deviation.nb_cells, size_t(1)));
+  return deviation;
+}
+
+/**
+ * Sums up the deviation of several cycles
+ * @param deviation
+ * @param cycle_deviation
+ */
+void accumulateDeviation(FieldDeviation& deviation, const FieldDeviation& cycle_deviation)
+{
+  const size_t nb_cells = deviation.nb_cells + cycle_deviation.nb_cells;
+  deviation.mean_h_prox = (deviation.mean_h_prox * static_cast<double>(deviation.nb_cells) +
+                           cycle_deviation.mean_h_prox * static_cast<double>(cycle_deviation.nb_cells)) /
+                          static_cast<double>(std::max(nb_cells, size_t(1)));
+  deviation.tolerance = cycle_deviation.tolerance;
+  deviation.nb_cells = nb_cells;
+  deviation.nb_nonzero += cycle_deviation.nb_nonzero;
+  deviation.nb_exceeding += cycle_deviation.nb_exceeding;
+  deviation.max_h_prox = std::max(deviation.max_h_prox, cycle_deviation.max_h_prox);
+  deviation.max_motion_res = std::max(deviation.max_motion_res, cycle_deviation.max_motion_res);
+}
+
+/**
+ * Prints the deviation of a field from its reference
+ * @param name
+ * @param deviation
+ */
+void printDeviation(const char* name, const FieldDeviation& deviation)
+{
+  std::printf("  %s: h_prox max %.4f, mean %.5f over %zu cells, %zu of %zu non-zero cells above %.2f, "
+              "motion res max %.4f\n",
+              name,
+              deviation.max_h_prox,
+              deviation.mean_h_prox,
+              deviation.nb_cells,
+              deviation.nb_exceeding,
+              deviation.nb_nonzero,
+              deviation.tolerance,
+              deviation.max_motion_res);
+}
+}  // namespace
+
+/**
+ * Voronoi potential field of the EDT backend on the full patch against the Fortune backend. Fortune only calculates
+ * the FORTUNE_DIM window around the ego vehicle, the fields are compared within it
+ */
+void benchmarkVoronoiBackends()
+{
+  BenchmarkEnvironment fortune_env(BenchmarkEnvironment::ConfigChanges{ { "VORONOI_BACKEND", "0" } });
+  BenchmarkEnvironment edt_env({ { "VORONOI_BACKEND", "1" }, { "VORONOI_TILE_DIM", "0" } });
+  fortune_env.recalculateEnv();
+  edt_env.recalculateEnv();
+
+  const double fortune_ms =
+      measureMs([&]() { fortune_env.astar_.calcVoronoiPotentialField(fortune_env.ego_index_); }, NB_RUNS);
+  const double edt_ms = measureMs([&]() { edt_env.astar_.calcVoronoiPotentialField(edt_env.ego_index_); }, NB_RUNS);
+
+  const int astar_dim = edt_env.astar_.astar_dim_;
+  const Point<int> window_min(std::max(edt_env.ego_index_.x - FORTUNE_DIM / 2, 0),
+                              std::max(edt_env.ego_index_.y - FORTUNE_DIM / 2, 0));
+  const Point<int> window_max(std::min(window_min.x + FORTUNE_DIM, astar_dim),
+                              std::min(window_min.y + FORTUNE_DIM, astar_dim));
+
+  std::printf("Voronoi potential field on a %dx%d patch (%dx%d planner cells), fastest of %d runs\n",
+              BENCHMARK_DIM,
+              BENCHMARK_DIM,
+              astar_dim,
+              astar_dim,
+              NB_RUNS);
+  std::printf("  Fortune, %dx%d window    %7.2f ms\n", FORTUNE_DIM, FORTUNE_DIM, fortune_ms);
+  std::printf("  EDT, full patch          %7.2f ms, speedup %.2f\n", edt_ms, fortune_ms / edt_ms);
+  printDeviation("EDT against Fortune",
+                 compareFields(edt_env, fortune_env, window_min, window_max, FORTUNE_H_PROX_TOLERANCE));
+}
+
+/**
+ * Voronoi potential field of the EDT backend with cached tiles against the full patch. Every cycle occupies or frees a
+ * few random boxes of the planner grid, the tiled backend only recalculates the tiles around them. The fields are
+ * compared on the full patch after every cycle
+ */
+void benchmarkVoronoiTiles()
+{
+  const std::string config_tile_dim = YAML::LoadFile(FREESPACE_PLANNER_CONFIG)["VORONOI_TILE_DIM"].as<std::string>();
+  BenchmarkEnvironment tiled_env({ { "VORONOI_BACKEND", "1" }, { "VORONOI_TILE_DIM", config_tile_dim } });
+  BenchmarkEnvironment full_env({ { "VORONOI_BACKEND", "1" }, { "VORONOI_TILE_DIM", "0" } });
+  tiled_env.recalculateEnv();
+  full_env.recalculateEnv();
+
+  const int astar_dim = full_env.astar_.astar_dim_;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> size_distribution(2, 6);
+  std::uniform_int_distribution<int> pos_distribution(0, astar_dim - 7);
+  std::uniform_int_distribution<int> occ_distribution(0, 1);
+
+  double tiled_ms = 0;
+  double full_ms = 0;
+  FieldDeviation deviation;
+  for (int cycle = 0; cycle < NB_CYCLES; ++cycle)
+  {
+    for (int change = 0; change < NB_CHANGES; ++change)
+    {
+      const int x_min = pos_distribution(generator);
+      const int y_min = pos_distribution(generator);
+      const int x_max = x_min + size_distribution(generator);
+      const int y_max = y_min + size_distribution(generator);
+      const uint8_t cell = occ_distribution(generator) != 0 ? CollisionChecker::OCC : CollisionChecker::FREE;
+      for (int y_ind = y_min; y_ind < y_max; ++y_ind)
+      {
+        for (int x_ind = x_min; x_ind < x_max; ++x_ind)
+        {
+          tiled_env.astar_.astar_grid_(y_ind, x_ind) = cell;
+          full_env.astar_.astar_grid_(y_ind, x_ind) = cell;
+        }
+      }
+    }
+
+    tiled_ms += measureMs([&]() { tiled_env.astar_.calcVoronoiPotentialField(tiled_env.ego_index_); }, 1);
+    full_ms += measureMs([&]() { full_env.astar_.calcVoronoiPotentialField(full_env.ego_index_); }, 1);
+    accumulateDeviation(
+        deviation, compareFields(tiled_env, full_env, { 0, 0 }, { astar_dim, astar_dim }, TILE_H_PROX_TOLERANCE));
+  }
+
+  std::printf("Voronoi potential field on a %dx%d patch (%dx%d planner cells), %d cycles with %d changed boxes each\n",
+              BENCHMARK_DIM,
+              BENCHMARK_DIM,
+              astar_dim,
+              astar_dim,
+              NB_CYCLES,
+              NB_CHANGES);
+  std::printf("  EDT, full patch          %7.2f ms per cycle\n", full_ms / NB_CYCLES);
+  std::printf("  EDT, %3s cell tiles      %7.2f ms per cycle, speedup %.2f\n",
+              config_tile_dim.c_str(),
+              tiled_ms / NB_CYCLES,
+              full_ms / tiled_ms);
+  printDeviation("tiles against full patch", deviation);
+}
@@ -17,6 +17,7 @@ void Cartographing::resetPatch(size_t patch_dim)
 void Cartographing::cartograph(const py::array_t<uint8_t>& local_map, const Point<int>& origin, int dim)
 {
   auto local_map_data = local_map.unchecked<2>();
+  patch_arr_.unshare();
 
   std::vector<uint8_t> values;
   for (int x_idx = 0; x_idx < dim; ++x_idx)
@@ -52,6 +53,7 @@ void Cartographing::cartograph(const py::array_t<uint8_t>& local_map, const Poin
 void Cartographing::cartograph(const Vec2DFlat<uint8_t>& local_map_data, const Point<int>& origin, int dim)
 {
   //  auto local_map_data = local_map.unchecked<2>();
+  patch_arr_.unshare();
 
   std::vector<uint8_t> values;
   for (int x_idx = 0; x_idx < dim; ++x_idx)
@@ -103,23 +105,26 @@ void Cartographing::passLocalMap(const Point<int>& origin, int dim)
                 dim * data_size);
   }
   // pass cartographed data to collision checker
-  CollisionChecker::passLocalMapData(local_map_.getPtr(), origin, dim);
+  collision_checker_.passLocalMapData(local_map_.getPtr(), origin, dim);
 }
 
 void Cartographing::loadPrevPatch(const Point<double>& prev_origin_utm, const Point<double>& origin_utm)
 {
-  const Point<int> prev_origin_gm = (prev_origin_utm * grid_tf::con2gm_).toInt();
-  const Point<int> next_origin_gm = (origin_utm * grid_tf::con2gm_).toInt();
+  const Point<int> prev_origin_gm = (prev_origin_utm * grid_tf_.con2gm_).toInt();
+  const Point<int> next_origin_gm = (origin_utm * grid_tf_.con2gm_).toInt();
 
   util::copyPatch2Patch(prev_origin_gm, next_origin_gm, patch_arr_, temp_patch_);
 
   // Copy cartographed patch_info to collision checker
   const Point<int> origin(0, 0);
-  CollisionChecker::passLocalMapData(patch_arr_.getPtr(), origin, static_cast<int>(patch_dim_));
+  collision_checker_.passLocalMapData(patch_arr_.getPtr(), origin, static_cast<int>(patch_dim_));
 }
 
-py::array_t<uint8_t> Cartographing::getMap()
+/**
+ * Cartographed patch as read only view
+ * @return
+ */
+py::array_t<uint8_t> Cartographing::getMap() const
 {
-  return py::array_t<uint8_t>({ patch_dim_, patch_dim_ },  // shape
-                              patch_arr_.getPtr());
+  return patch_arr_.getNumpyArr();
 }
@@ -23,10 +23,19 @@ void CollisionChecker::initialize(size_t patch_dim, const std::string& path2conf
   len_per_disk_ = config["LEN_PER_DISK"].as<double>();
   double_disk_rows_ = config["DOUBLE_DISK_ROWS"].as<bool>();
   max_patch_ins_dist_ = config["MAX_PATCH_INS_DIST"].as<double>();
+  dilation_backend_ = static_cast<DilationBackend>(config["DILATION_BACKEND"].as<int>());
+#ifndef USE_CUDA
+  if (dilation_backend_ == DILATION_CUDA)
+  {
+    std::cout << "Built without CUDA, using the CPU dilation backend" << std::endl;
+    dilation_backend_ = DILATION_CPU;
+  }
+#endif
+  dilation_pool_.resize(config["DILATION_THREADS"].as<size_t>());
 
   // Transforms
-  // grid_tf::con2gm_ = 1 / gm_res_;
-  grid_tf::updateGmRes(gm_res_);
+  // grid_tf_.con2gm_ = 1 / gm_res_;
+  grid_tf_.updateGmRes(gm_res_);
 
   resetPatch(patch_dim);
 
@@ -70,9 +79,9 @@ std::vector<double> CollisionChecker::getDiskPositions(double radius, unsigned i
 void CollisionChecker::calculateDisks()
 {
   // set number and width of vehicle
-  double eff_width = Vehicle::width_;
+  double eff_width = vehicle_.width_;
   int disk_mult = 1;
-  unsigned int eff_nb_disks = static_cast<int>(std::ceil(Vehicle::length_ / CollisionChecker::len_per_disk_));
+  unsigned int eff_nb_disks = static_cast<int>(std::ceil(vehicle_.length_ / len_per_disk_));
 
   if (double_disk_rows_)
   {
@@ -82,24 +91,42 @@ void CollisionChecker::calculateDisks()
   nb_disks_ = disk_mult * eff_nb_disks;
 
   // set effective width
-  eff_width = Vehicle::width_ / disk_mult;
+  eff_width = vehicle_.width_ / disk_mult;
 
   // Resize vectors to actual size
   disk_centers_.resize_and_reset(nb_disks_, nb_disc_yaws_, Point<int>(0, 0));
+  disks_version_++;
   disk_centers_.setName("disk_centers");
 
   // Calculate disk radius and position
-  double disk_radius = getDiskRadius(Vehicle::length_, eff_width, eff_nb_disks);
-  std::vector<double> disk_positions = getDiskPositions(disk_radius, eff_nb_disks, eff_width, Vehicle::lb_);
+  double disk_radius = getDiskRadius(vehicle_.length_, eff_width, eff_nb_disks);
+  std::vector<double> disk_positions = getDiskPositions(disk_radius, eff_nb_disks, eff_width, vehicle_.lb_);
 
   // Prepare dilation filter
   double safety_disk_radius = disk_radius + safety_distance_m_;
-  disk_r_c_ = std::ceil(safety_disk_radius * grid_tf::con2gm_);
+  disk_r_c_ = std::ceil(safety_disk_radius * grid_tf_.con2gm_);
   disk_diameter_c_ = 2 * disk_r_c_ + 1;
 
   dil_kernel_ = getStructuringElement(
       cv::MORPH_ELLIPSE, cv::Size(disk_diameter_c_, disk_diameter_c_), cv::Point(disk_r_c_, disk_r_c_));
+#ifdef USE_CUDA
   dilateFilter_ = cv::cuda::createMorphologyFilter(cv::MORPH_DILATE, CV_8UC1, dil_kernel_);
+#endif
+
+  // The rows of the elliptic kernel are intervals centered at the anchor
+  kernel_half_widths_.assign(disk_diameter_c_, -1);
+  for (int row = 0; row < disk_diameter_c_; ++row)
+  {
+    int nb_set = 0;
+    for (int col = 0; col < disk_diameter_c_; ++col)
+    {
+      nb_set += dil_kernel_.at<uint8_t>(row, col) != 0 ? 1 : 0;
+    }
+    if (nb_set > 0)
+    {
+      kernel_half_widths_[row] = (nb_set - 1) / 2;
+    }
+  }
 
   // Precalculate disk positions
   unsigned int max_yaw_idx = (360 / yaw_res_coll_);
@@ -117,12 +144,12 @@ void CollisionChecker::calculateDisks()
       {
         y_offset = eff_width / 2.0;
         const Point<double> disk_point1(disk_pos, y_offset);
-        const Point<int> disk_point_rot1 = (disk_point1.rotate(yaw) * grid_tf::con2gm_).toInt();
+        const Point<int> disk_point_rot1 = (disk_point1.rotate(yaw) * grid_tf_.con2gm_).toInt();
         disk_centers_(yaw_idx, disk_idx) = disk_point_rot1;
 
         y_offset = -eff_width / 2.0;
         const Point<double> disk_point2 = { disk_pos, y_offset };
-        const Point<int> disk_point_rot2 = (disk_point2.rotate(yaw) * grid_tf::con2gm_).toInt();
+        const Point<int> disk_point_rot2 = (disk_point2.rotate(yaw) * grid_tf_.con2gm_).toInt();
         disk_centers_(yaw_idx, disk_idx + 1) = disk_point_rot2;
         disk_idx += 2;
       }
@@ -130,7 +157,7 @@ void CollisionChecker::calculateDisks()
       {
         y_offset = 0;
         const Point<double> disk_point1(disk_pos, y_offset);
-        const Point<int> disk_point_rot1 = (disk_point1.rotate(yaw) * grid_tf::con2gm_).toInt();
+        const Point<int> disk_point_rot1 = (disk_point1.rotate(yaw) * grid_tf_.con2gm_).toInt();
         disk_centers_(yaw_idx, disk_idx) = disk_point_rot1;
         disk_idx += 1;
       }
@@ -161,9 +188,9 @@ void CollisionChecker::insertMinipatches(const std::map<std::pair<int, int>, Min
     }
 
     // calculate origin on grm
-    const auto origin_grid = grid_tf::utm2grid_round(grid_tf::utm2patch_utm(minipatch.origin_));
+    const auto origin_grid = grid_tf_.utm2grid_round(grid_tf_.utm2patch_utm(minipatch.origin_));
 
-    CollisionChecker::passLocalMap(minipatch.patch_, origin_grid, minipatch.width_);
+    passLocalMap(minipatch.patch_, origin_grid, minipatch.width_);
   }
 }
 
@@ -181,10 +208,24 @@ void CollisionChecker::passLocalMap(const py::array_t<uint8_t>& local_map, const
  */
 void CollisionChecker::passLocalMap(const Vec2DFlat<uint8_t>& local_map, const Point<int>& origin, int dim)
 {
-  passLocalMapData(local_map.data().data(), origin, dim);
+  passLocalMapData(local_map.getPtr(), origin, dim);
 }
 
 void CollisionChecker::processSafetyPatch()
+{
+  patch_safety_arr_.unshare();
+#ifdef USE_CUDA
+  if (dilation_backend_ == DILATION_CUDA)
+  {
+    processSafetyPatchCuda();
+    return;
+  }
+#endif
+  processSafetyPatchCpu();
+}
+
+#ifdef USE_CUDA
+void CollisionChecker::processSafetyPatchCuda()
 {
   // Copy to matImg
   cv::Mat matImg(patch_dim_, patch_dim_, CV_8UC1);
@@ -203,6 +244,93 @@ void CollisionChecker::processSafetyPatch()
 
   std::memcpy(patch_safety_arr_.getPtr(), matImg.data, patch_dim_ * patch_dim_ * sizeof(uint8_t));
 }
+#endif
+
+/**
+ * Thresholding and dilation with the elliptic kernel on the CPU.
+ * As there are only three values, the dilation is done by distances: Every row stores the horizontal distance to the
+ * next occupied and the next not free cell while it is thresholded. A cell is occupied after the dilation if any
+ * kernel row finds an occupied cell within its half width, the same holds for unknown.
+ */
+void CollisionChecker::processSafetyPatchCpu()
+{
+  const int dim = static_cast<int>(patch_dim_);
+  const int kernel_r = static_cast<int>(kernel_half_widths_.size()) / 2;
+  occ_dist_.resize(patch_dim_ * patch_dim_);
+  unknown_dist_.resize(patch_dim_ * patch_dim_);
+
+  const size_t nb_stripes = std::min(dilation_pool_.size(), patch_dim_);
+
+  // Threshold and horizontal distances
+  dilation_pool_.parallelFor(nb_stripes, [this, dim, nb_stripes](size_t stripe) {
+    constexpr int MAX_DIST = 255;
+    const int row_begin = static_cast<int>(stripe * dim / nb_stripes);
+    const int row_end = static_cast<int>((stripe + 1) * dim / nb_stripes);
+    for (int y = row_begin; y < row_end; ++y)
+    {
+      const uint8_t* in_row = patch_arr_.getPtr() + static_cast<size_t>(y) * dim;
+      uint8_t* occ_row = occ_dist_.data() + static_cast<size_t>(y) * dim;
+      uint8_t* unknown_row = unknown_dist_.data() + static_cast<size_t>(y) * dim;
+
+      int occ_d = MAX_DIST;
+      int unknown_d = MAX_DIST;
+      for (int x = 0; x < dim; ++x)
+      {
+        const bool is_occ = in_row[x] > max_thresh_;
+        const bool is_free = in_row[x] < min_thresh_;
+        occ_d = is_occ ? 0 : std::min(occ_d + 1, MAX_DIST);
+        unknown_d = !is_free ? 0 : std::min(unknown_d + 1, MAX_DIST);
+        occ_row[x] = occ_d;
+        unknown_row[x] = unknown_d;
+      }
+      occ_d = MAX_DIST;
+      unknown_d = MAX_DIST;
+      for (int x = dim - 1; x >= 0; --x)
+      {
+        occ_d = std::min({ occ_d + 1, MAX_DIST, static_cast<int>(occ_row[x]) });
+        unknown_d = std::min({ unknown_d + 1, MAX_DIST, static_cast<int>(unknown_row[x]) });
+        occ_row[x] = occ_d;
+        unknown_row[x] = unknown_d;
+      }
+    }
+  });
+
+  // Vertical combination with the kernel rows
+  dilation_pool_.parallelFor(nb_stripes, [this, dim, kernel_r, nb_stripes](size_t stripe) {
+    const int row_begin = static_cast<int>(stripe * dim / nb_stripes);
+    const int row_end = static_cast<int>((stripe + 1) * dim / nb_stripes);
+    std::vector<uint8_t> is_occ(dim);
+    std::vector<uint8_t> is_unknown(dim);
+    for (int y = row_begin; y < row_end; ++y)
+    {
+      std::fill(is_occ.begin(), is_occ.end(), 0);
+      std::fill(is_unknown.begin(), is_unknown.end(), 0);
+      for (int dy = -kernel_r; dy <= kernel_r; ++dy)
+      {
+        const int half_width = kernel_half_widths_[dy + kernel_r];
+        const int y_kernel = y + dy;
+        if (half_width < 0 || y_kernel < 0 || y_kernel >= dim)
+        {
+          continue;
+        }
+        const uint8_t* occ_row = occ_dist_.data() + static_cast<size_t>(y_kernel) * dim;
+        const uint8_t* unknown_row = unknown_dist_.data() + static_cast<size_t>(y_kernel) * dim;
+        for (int x = 0; x < dim; ++x)
+        {
+          is_occ[x] |= static_cast<uint8_t>(occ_row[x] <= half_width);
+          is_unknown[x] |= static_cast<uint8_t>(unknown_row[x] <= half_width);
+        }
+      }
+
+      uint8_t* out_row = patch_safety_arr_.getPtr() + static_cast<size_t>(y) * dim;
+      for (int x = 0; x < dim; ++x)
+      {
+        out_row[x] = is_occ[x] != 0 ? OCC : (is_unknown[x] != 0 ? UNKNOWN : FREE);
+      }
+    }
+  });
+}
+
 /**
  * Passes a local map to the collision checker
  * @param local_map
@@ -254,6 +382,7 @@ void CollisionChecker::passLocalMapData(const unsigned char* local_map_data, con
   // Copy values of local map to internal patch
   //  int size_data_safety = sizeof(uint8_t);
   int size_data_patch = sizeof(uint8_t);
+  patch_arr_.unshare();
   for (size_t i = 0; i < dim; ++i)
   {
     // Boundary checking for y: only rows inside patch are copied completely
@@ -275,7 +404,7 @@ void CollisionChecker::passLocalMapData(const unsigned char* local_map_data, con
   }
 }
 
-std::vector<Point<int>> CollisionChecker::returnDiskPositions(double yaw)
+std::vector<Point<int>> CollisionChecker::returnDiskPositions(double yaw) const
 {
   std::vector<Point<int>> points;
   points.reserve(nb_disks_);
@@ -288,7 +417,7 @@ std::vector<Point<int>> CollisionChecker::returnDiskPositions(double yaw)
   return points;
 }
 
-int CollisionChecker::getYawIdx(double yaw)
+int CollisionChecker::getYawIdx(double yaw) const
 {
   int yaw_idx = static_cast<int>(util::constrainAngleZero2Pi(yaw) / yaw_res_coll_rad_);
   return std::min(yaw_idx, static_cast<int>(nb_disc_yaws_ - 1));
@@ -299,7 +428,7 @@ int CollisionChecker::getYawIdx(double yaw)
  * @param pose
  * @return
  */
-bool CollisionChecker::checkGrid(const Pose<int>& pose)
+bool CollisionChecker::checkGrid(const Pose<int>& pose) const
 {
   for (int disk_idx = 0; disk_idx < nb_disks_; ++disk_idx)
   {
@@ -324,7 +453,7 @@ bool CollisionChecker::checkGrid(const Pose<int>& pose)
  * @param pose
  * @return
  */
-bool CollisionChecker::checkGridVariant(const Pose<int>& pose)
+bool CollisionChecker::checkGridVariant(const Pose<int>& pose) const
 {
   for (int disk_idx = 0; disk_idx < nb_disks_; ++disk_idx)
   {
@@ -344,11 +473,11 @@ bool CollisionChecker::checkGridVariant(const Pose<int>& pose)
   return true;  // no collision
 }
 
-bool CollisionChecker::checkPose(const Pose<double>& pose)
+bool CollisionChecker::checkPose(const Pose<double>& pose) const
 {
   // Position on grid
   const Pose<int> pose2check(
-      static_cast<int>(pose.x * grid_tf::con2gm_), static_cast<int>(pose.y * grid_tf::con2gm_), getYawIdx(pose.yaw));
+      static_cast<int>(pose.x * grid_tf_.con2gm_), static_cast<int>(pose.y * grid_tf_.con2gm_), getYawIdx(pose.yaw));
 
   return checkGrid(pose2check);
 }
@@ -357,11 +486,11 @@ bool CollisionChecker::checkPose(const Pose<double>& pose)
  * @param pose
  * @return
  */
-bool CollisionChecker::checkPoseVariant(const Pose<double>& pose)
+bool CollisionChecker::checkPoseVariant(const Pose<double>& pose) const
 {
   // Position on grid
   const Pose<int> pose2check(
-      static_cast<int>(pose.x * grid_tf::con2gm_), static_cast<int>(pose.y * grid_tf::con2gm_), getYawIdx(pose.yaw));
+      static_cast<int>(pose.x * grid_tf_.con2gm_), static_cast<int>(pose.y * grid_tf_.con2gm_), getYawIdx(pose.yaw));
 
   return checkGridVariant(pose2check);
 }
@@ -375,7 +504,7 @@ bool CollisionChecker::checkPoseVariant(const Pose<double>& pose)
  */
 bool CollisionChecker::checkPathCollision(const std::vector<double>& x_list,
                                           const std::vector<double>& y_list,
-                                          const std::vector<double>& yaw_list)
+                                          const std::vector<double>& yaw_list) const
 {
   //  for (int i = static_cast<int>(x_list.size()) - 1; i >= 0; --i)  // start from the beginning
   for (size_t i = 0, max = x_list.size(); i < max; ++i)
@@ -397,7 +526,7 @@ bool CollisionChecker::checkPathCollision(const std::vector<double>& x_list,
  */
 int CollisionChecker::getPathCollisionIndex(const std::vector<double>& x_list,
                                             const std::vector<double>& y_list,
-                                            const std::vector<double>& yaw_list)
+                                            const std::vector<double>& yaw_list) const
 {
   for (size_t i = 0, max = x_list.size(); i < max; ++i)
   {
@@ -407,4 +536,66 @@ int CollisionChecker::getPathCollisionIndex(const std::vector<double>& x_list,
     }
   }
   return -1;  // subpath is valid
-}
\ No newline at end of file
+}
+
+/**
+ * Get the unique grid cells that are checked for a path, the disk centers of consecutive poses often fall into the
+ * same cell
+ * @param x_list
+ * @param y_list
+ * @param yaw_list
+ * @return
+ */
+std::vector<Point<int>> CollisionChecker::getSweptCells(const std::vector<double>& x_list,
+                                                        const std::vector<double>& y_list,
+                                                        const std::vector<double>& yaw_list) const
+{
+  std::vector<Point<int>> cells;
+  cells.reserve(x_list.size() * nb_disks_);
+  for (size_t i = 0, max = x_list.size(); i < max; ++i)
+  {
+    const Point<int> pose_cell(static_cast<int>(x_list[i] * grid_tf_.con2gm_),
+                               static_cast<int>(y_list[i] * grid_tf_.con2gm_));
+    const int yaw_idx = getYawIdx(yaw_list[i]);
+    for (unsigned int disk_idx = 0; disk_idx < nb_disks_; ++disk_idx)
+    {
+      cells.push_back(disk_centers_(yaw_idx, disk_idx) + pose_cell);
+    }
+  }
+
+  std::sort(cells.begin(), cells.end(), [](const Point<int>& lhs, const Point<int>& rhs) {
+    return std::tie(lhs.y, lhs.x) < std::tie(rhs.y, rhs.x);
+  });
+  const auto is_same = [](const Point<int>& lhs, const Point<int>& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; };
+  cells.erase(std::unique(cells.begin(), cells.end(), is_same), cells.end());
+
+  return cells;
+}
+
+/**
+ * Check cells relative to an origin cell, same result as checkGrid for every contained disk center
+ * @param origin
+ * @param cells
+ * @return
+ */
+bool CollisionChecker::checkSweptCells(const Point<int>& origin, std::span<const Point<int>> cells) const
+{
+  const int patch_dim = static_cast<int>(patch_dim_);
+  for (const Point<int>& cell : cells)
+  {
+    const int x = origin.x + cell.x;
+    const int y = origin.y + cell.y;
+
+    // out of map
+    if (x >= patch_dim || y >= patch_dim || x < 0 || y < 0)
+    {
+      return false;  // not valid
+    }
+    // collides with grid
+    if (patch_safety_arr_(y, x) == OCC)
+    {
+      return false;  // collision
+    }
+  }
+  return true;  // no collision
+}
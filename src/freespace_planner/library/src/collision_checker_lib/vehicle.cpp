@@ -30,12 +30,12 @@ void Vehicle::initialize(double max_steer, double w_b, double l_f, double l_b, d
   vehicle_vertices_ = { f_l_corner_, f_r_corner_, r_r_corner_, r_l_corner_ };
 }
 
-std::vector<Point<double>> Vehicle::getVehicleVertices()
+std::vector<Point<double>> Vehicle::getVehicleVertices() const
 {
   return vehicle_vertices_;
 }
 
-void Vehicle::move(Pose<double>& pose, double distance, double steer)
+void Vehicle::move(Pose<double>& pose, double distance, double steer) const
 {
   /**
    * Integrate a certain distance and steering angle forward
@@ -91,8 +91,11 @@ MotionPrimitive Vehicle::turn_on_rear_axis(const Pose<double>& pose, double delt
   return motion_primitive;
 }
 
-MotionPrimitive
-Vehicle::move_car_some_steps(const Pose<double>& pose, double arc_l, double motion_res, int direction, double steer)
+MotionPrimitive Vehicle::move_car_some_steps(const Pose<double>& pose,
+                                             double arc_l,
+                                             double motion_res,
+                                             int direction,
+                                             double steer) const
 {
   // Number of columns for pose vector
   auto nb_elements = static_cast<size_t>(round(arc_l / motion_res));
@@ -2,10 +2,15 @@
 
 void Pooling::init(int pooling_dim) {
 
-  checkCUDNN(cudnnCreate(&cudnn_));
+  const std::lock_guard<std::mutex> lock(mutex_);
 
-  //create descriptor handle
-  checkCUDNN(cudnnCreatePoolingDescriptor(&pooling_desc_));
+  // every planner context initializes the pooling, the handles are only created once
+  if (cudnn_ == nullptr) {
+    checkCUDNN(cudnnCreate(&cudnn_));
+
+    //create descriptor handle
+    checkCUDNN(cudnnCreatePoolingDescriptor(&pooling_desc_));
+  }
   //initialize descriptor
   checkCUDNN(cudnnSetPooling2dDescriptor(pooling_desc_,            //descriptor handle
                                          CUDNN_POOLING_MAX,       //mode - max pooling
@@ -18,20 +23,25 @@ void Pooling::init(int pooling_dim) {
                                          pooling_dim));                     //horizontal stride
 }
 
-void Pooling::execute(const uint8_t* image_pointer, uint8_t *result, int in_dim, int out_dim) {
+void Pooling::reserve(int in_dim, int out_dim) {
 
-//  auto t0 = std::chrono::high_resolution_clock::now();
+  if (in_dim == in_dim_ && out_dim == out_dim_) {
+    return;
+  }
 
-  const size_t in_data_bytes = in_dim * in_dim * sizeof(uint8_t);
-  const size_t out_data_bytes = out_dim * out_dim * sizeof(uint8_t);
+  if (in_data_ != nullptr) {
+    cudaFree(in_data_);
+    cudaFree(out_data_);
+    checkCUDNN(cudnnDestroyTensorDescriptor(in_desc_));
+    checkCUDNN(cudnnDestroyTensorDescriptor(out_desc_));
+  }
 
-  // GPU data pointers
-  uint8_t *in_data;
-  uint8_t *out_data;
-  // allocate arrays on GPU
-  cudaMalloc(&in_data, in_data_bytes);
-  cudaMalloc(&out_data, out_data_bytes);
+  in_dim_ = in_dim;
+  out_dim_ = out_dim;
 
+  // allocate arrays on GPU, they are kept until the dimensions change
+  cudaMalloc(&in_data_, in_dim * in_dim * sizeof(uint8_t));
+  cudaMalloc(&out_data_, out_dim * out_dim * sizeof(uint8_t));
 
   //create input data tensor descriptor
   checkCUDNN(cudnnCreateTensorDescriptor(&in_desc_));
@@ -54,29 +64,32 @@ void Pooling::execute(const uint8_t* image_pointer, uint8_t *result, int in_dim,
                                         1,                        //number of channels
                                         out_dim,                        //data height
                                         out_dim));                      //data width
+}
+
+void Pooling::execute(const uint8_t* image_pointer, uint8_t *result, int in_dim, int out_dim) {
+
+//  auto t0 = std::chrono::high_resolution_clock::now();
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+
+  reserve(in_dim, out_dim);
 
   //copy input data to GPU array
-  cudaMemcpy(in_data, image_pointer, in_data_bytes, cudaMemcpyHostToDevice);
+  cudaMemcpy(in_data_, image_pointer, in_dim * in_dim * sizeof(uint8_t), cudaMemcpyHostToDevice);
 
   //Call pooling operator
   checkCUDNN(cudnnPoolingForward(cudnn_,         //cuDNN context handle
                                  pooling_desc_,  //pooling descriptor handle
                                  &alpha_,        //alpha scaling factor
                                  in_desc_,       //input tensor descriptor
-                                 in_data,       //input data pointer to GPU memory
+                                 in_data_,       //input data pointer to GPU memory
                                  &beta_,         //beta scaling factor
                                  out_desc_,      //output tensor descriptor
-                                 out_data));    //output data pointer from GPU memory
+                                 out_data_));    //output data pointer from GPU memory
 
   //copy output data from GPU
-  cudaMemcpy(result, out_data, out_data_bytes, cudaMemcpyDeviceToHost);
-
-  cudaFree(in_data);
-  cudaFree(out_data);
+  cudaMemcpy(result, out_data_, out_dim * out_dim * sizeof(uint8_t), cudaMemcpyDeviceToHost);
 
 //  auto t1 = std::chrono::high_resolution_clock::now();
 //  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
 }
-
-
-
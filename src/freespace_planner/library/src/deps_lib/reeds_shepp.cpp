@@ -75,6 +75,30 @@ inline void tauOmega(double u, double v, double xi, double eta, double phi, doub
   omega = mod2pi(tau - u + v - phi);
 }
 
+// The word families either store the complete shortest path or only its length
+inline double candidateLength(const ReedsSheppStateSpace::ReedsSheppPath& path)
+{
+  return path.length();
+}
+inline double candidateLength(double length)
+{
+  return length;
+}
+inline void setCandidate(ReedsSheppStateSpace::ReedsSheppPath& path,
+                         int type,
+                         double t,
+                         double u,
+                         double v,
+                         double w = 0.,
+                         double x = 0.)
+{
+  path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[type], t, u, v, w, x);
+}
+inline void setCandidate(double& length, int /*type*/, double t, double u, double v, double w = 0., double x = 0.)
+{
+  length = fabs(t) + fabs(u) + fabs(v) + fabs(w) + fabs(x);
+}
+
 // formula 8.1 in Reeds-Shepp paper
 inline bool LpSpLp(double x, double y, double phi, double& t, double& u, double& v)
 {
@@ -113,51 +137,52 @@ inline bool LpSpRp(double x, double y, double phi, double& t, double& u, double&
   }
   return false;
 }
-void CSC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath& path)
+template <typename Candidate>
+void CSC(double x, double y, double phi, Candidate& path)
 {
   double t;
   double u;
   double v;
-  double Lmin = path.length();
+  double Lmin = candidateLength(path);
   double L;
   if (LpSpLp(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[14], t, u, v);
+    setCandidate(path, 14, t, u, v);
     Lmin = L;
   }
   if (LpSpLp(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[14], -t, -u, -v);
+    setCandidate(path, 14, -t, -u, -v);
     Lmin = L;
   }
   if (LpSpLp(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[15], t, u, v);
+    setCandidate(path, 15, t, u, v);
     Lmin = L;
   }
   if (LpSpLp(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip + reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[15], -t, -u, -v);
+    setCandidate(path, 15, -t, -u, -v);
     Lmin = L;
   }
   if (LpSpRp(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[12], t, u, v);
+    setCandidate(path, 12, t, u, v);
     Lmin = L;
   }
   if (LpSpRp(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[12], -t, -u, -v);
+    setCandidate(path, 12, -t, -u, -v);
     Lmin = L;
   }
   if (LpSpRp(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[13], t, u, v);
+    setCandidate(path, 13, t, u, v);
     Lmin = L;
   }
   if (LpSpRp(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {  // timeflip + reflect
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[13], -t, -u, -v);
+    setCandidate(path, 13, -t, -u, -v);
   }
 }
 // formula 8.3 / 8.4  *** TYPO IN PAPER ***
@@ -180,31 +205,32 @@ inline bool LpRmL(double x, double y, double phi, double& t, double& u, double&
   }
   return false;
 }
-void CCC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath& path)
+template <typename Candidate>
+void CCC(double x, double y, double phi, Candidate& path)
 {
   double t;
   double u;
   double v;
-  double Lmin = path.length();
+  double Lmin = candidateLength(path);
   double L;
   if (LpRmL(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[0], t, u, v);
+    setCandidate(path, 0, t, u, v);
     Lmin = L;
   }
   if (LpRmL(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[0], -t, -u, -v);
+    setCandidate(path, 0, -t, -u, -v);
     Lmin = L;
   }
   if (LpRmL(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[1], t, u, v);
+    setCandidate(path, 1, t, u, v);
     Lmin = L;
   }
   if (LpRmL(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip + reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[1], -t, -u, -v);
+    setCandidate(path, 1, -t, -u, -v);
     Lmin = L;
   }
 
@@ -213,22 +239,22 @@ void CCC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath& p
   double yb = x * sin(phi) - y * cos(phi);
   if (LpRmL(xb, yb, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[0], v, u, t);
+    setCandidate(path, 0, v, u, t);
     Lmin = L;
   }
   if (LpRmL(-xb, yb, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[0], -v, -u, -t);
+    setCandidate(path, 0, -v, -u, -t);
     Lmin = L;
   }
   if (LpRmL(xb, -yb, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[1], v, u, t);
+    setCandidate(path, 1, v, u, t);
     Lmin = L;
   }
   if (LpRmL(-xb, -yb, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {  // timeflip + reflect
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[1], -v, -u, -t);
+    setCandidate(path, 1, -v, -u, -t);
   }
 }
 // formula 8.7
@@ -268,52 +294,53 @@ inline bool LpRumLumRp(double x, double y, double phi, double& t, double& u, dou
   }
   return false;
 }
-void CCCC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath& path)
+template <typename Candidate>
+void CCCC(double x, double y, double phi, Candidate& path)
 {
   double t;
   double u;
   double v;
-  double Lmin = path.length();
+  double Lmin = candidateLength(path);
   double L;
   if (LpRupLumRm(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[2], t, u, -u, v);
+    setCandidate(path, 2, t, u, -u, v);
     Lmin = L;
   }
   if (LpRupLumRm(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[2], -t, -u, u, -v);
+    setCandidate(path, 2, -t, -u, u, -v);
     Lmin = L;
   }
   if (LpRupLumRm(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[3], t, u, -u, v);
+    setCandidate(path, 3, t, u, -u, v);
     Lmin = L;
   }
   if (LpRupLumRm(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))  // timeflip + reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[3], -t, -u, u, -v);
+    setCandidate(path, 3, -t, -u, u, -v);
     Lmin = L;
   }
 
   if (LpRumLumRp(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[2], t, u, u, v);
+    setCandidate(path, 2, t, u, u, v);
     Lmin = L;
   }
   if (LpRumLumRp(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[2], -t, -u, -u, -v);
+    setCandidate(path, 2, -t, -u, -u, -v);
     Lmin = L;
   }
   if (LpRumLumRp(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[3], t, u, u, v);
+    setCandidate(path, 3, t, u, u, v);
     Lmin = L;
   }
   if (LpRumLumRp(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + 2. * fabs(u) + fabs(v)))
   {  // timeflip + reflect
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[3], -t, -u, -u, -v);
+    setCandidate(path, 3, -t, -u, -u, -v);
   }
 }
 // formula 8.9
@@ -357,52 +384,53 @@ inline bool LpRmSmRm(double x, double y, double phi, double& t, double& u, doubl
   }
   return false;
 }
-void CCSC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath& path)
+template <typename Candidate>
+void CCSC(double x, double y, double phi, Candidate& path)
 {
   double t;
   double u;
   double v;
-  double Lmin = path.length() - .5 * pi;
+  double Lmin = candidateLength(path) - .5 * pi;
   double L;
   if (LpRmSmLm(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[4], t, -.5 * pi, u, v);
+    setCandidate(path, 4, t, -.5 * pi, u, v);
     Lmin = L;
   }
   if (LpRmSmLm(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[4], -t, .5 * pi, -u, -v);
+    setCandidate(path, 4, -t, .5 * pi, -u, -v);
     Lmin = L;
   }
   if (LpRmSmLm(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[5], t, -.5 * pi, u, v);
+    setCandidate(path, 5, t, -.5 * pi, u, v);
     Lmin = L;
   }
   if (LpRmSmLm(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip + reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[5], -t, .5 * pi, -u, -v);
+    setCandidate(path, 5, -t, .5 * pi, -u, -v);
     Lmin = L;
   }
 
   if (LpRmSmRm(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[8], t, -.5 * pi, u, v);
+    setCandidate(path, 8, t, -.5 * pi, u, v);
     Lmin = L;
   }
   if (LpRmSmRm(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[8], -t, .5 * pi, -u, -v);
+    setCandidate(path, 8, -t, .5 * pi, -u, -v);
     Lmin = L;
   }
   if (LpRmSmRm(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[9], t, -.5 * pi, u, v);
+    setCandidate(path, 9, t, -.5 * pi, u, v);
     Lmin = L;
   }
   if (LpRmSmRm(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip + reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[9], -t, .5 * pi, -u, -v);
+    setCandidate(path, 9, -t, .5 * pi, -u, -v);
     Lmin = L;
   }
 
@@ -411,43 +439,43 @@ void CCSC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath&
   double yb = x * sin(phi) - y * cos(phi);
   if (LpRmSmLm(xb, yb, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[6], v, u, -.5 * pi, t);
+    setCandidate(path, 6, v, u, -.5 * pi, t);
     Lmin = L;
   }
   if (LpRmSmLm(-xb, yb, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[6], -v, -u, .5 * pi, -t);
+    setCandidate(path, 6, -v, -u, .5 * pi, -t);
     Lmin = L;
   }
   if (LpRmSmLm(xb, -yb, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[7], v, u, -.5 * pi, t);
+    setCandidate(path, 7, v, u, -.5 * pi, t);
     Lmin = L;
   }
   if (LpRmSmLm(-xb, -yb, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip + reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[7], -v, -u, .5 * pi, -t);
+    setCandidate(path, 7, -v, -u, .5 * pi, -t);
     Lmin = L;
   }
 
   if (LpRmSmRm(xb, yb, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[10], v, u, -.5 * pi, t);
+    setCandidate(path, 10, v, u, -.5 * pi, t);
     Lmin = L;
   }
   if (LpRmSmRm(-xb, yb, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[10], -v, -u, .5 * pi, -t);
+    setCandidate(path, 10, -v, -u, .5 * pi, -t);
     Lmin = L;
   }
   if (LpRmSmRm(xb, -yb, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[11], v, u, -.5 * pi, t);
+    setCandidate(path, 11, v, u, -.5 * pi, t);
     Lmin = L;
   }
   if (LpRmSmRm(-xb, -yb, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {  // timeflip + reflect
-    path = ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[11], -v, -u, .5 * pi, -t);
+    setCandidate(path, 11, -v, -u, .5 * pi, -t);
   }
 }
 // formula 8.11 *** TYPO IN PAPER ***
@@ -473,35 +501,32 @@ inline bool LpRmSLmRp(double x, double y, double phi, double& t, double& u, doub
   }
   return false;
 }
-void CCSCC(double x, double y, double phi, ReedsSheppStateSpace::ReedsSheppPath& path)
+template <typename Candidate>
+void CCSCC(double x, double y, double phi, Candidate& path)
 {
   double t;
   double u;
   double v;
-  double Lmin = path.length() - pi;
+  double Lmin = candidateLength(path) - pi;
   double L;
   if (LpRmSLmRp(x, y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {
-    path =
-        ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[16], t, -.5 * pi, u, -.5 * pi, v);
+    setCandidate(path, 16, t, -.5 * pi, u, -.5 * pi, v);
     Lmin = L;
   }
   if (LpRmSLmRp(-x, y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // timeflip
   {
-    path = ReedsSheppStateSpace::ReedsSheppPath(
-        ReedsSheppStateSpace::reedsSheppPathType[16], -t, .5 * pi, -u, .5 * pi, -v);
+    setCandidate(path, 16, -t, .5 * pi, -u, .5 * pi, -v);
     Lmin = L;
   }
   if (LpRmSLmRp(x, -y, -phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))  // reflect
   {
-    path =
-        ReedsSheppStateSpace::ReedsSheppPath(ReedsSheppStateSpace::reedsSheppPathType[17], t, -.5 * pi, u, -.5 * pi, v);
+    setCandidate(path, 17, t, -.5 * pi, u, -.5 * pi, v);
     Lmin = L;
   }
   if (LpRmSLmRp(-x, -y, phi, t, u, v) && Lmin > (L = fabs(t) + fabs(u) + fabs(v)))
   {  // timeflip + reflect
-    path = ReedsSheppStateSpace::ReedsSheppPath(
-        ReedsSheppStateSpace::reedsSheppPathType[17], -t, .5 * pi, -u, .5 * pi, -v);
+    setCandidate(path, 17, -t, .5 * pi, -u, .5 * pi, -v);
   }
 }
 
@@ -515,6 +540,17 @@ ReedsSheppStateSpace::ReedsSheppPath reedsShepp(double x, double y, double phi)
   CCSCC(x, y, phi, path);
   return path;
 }
+
+double reedsSheppLength(double x, double y, double phi)
+{
+  double length = std::numeric_limits<double>::max();
+  CSC(x, y, phi, length);
+  CCC(x, y, phi, length);
+  CCCC(x, y, phi, length);
+  CCSC(x, y, phi, length);
+  CCSCC(x, y, phi, length);
+  return length;
+}
 }  // namespace
 
 const std::array<std::array<ReedsSheppStateSpace::ReedsSheppPathSegmentType, 5>, 18>
@@ -557,20 +593,43 @@ ReedsSheppStateSpace::ReedsSheppPath::ReedsSheppPath(std::array<ReedsSheppPathSe
 
 double ReedsSheppStateSpace::distance(const Pose<double>& q_0, const Pose<double>& q_1) const
 {
-  return rho_ * reedsShepp(q_0, q_1).length();
+  double x;
+  double y;
+  double phi;
+  toLocal(q_0, q_1, x, y, phi);
+  return rho_ * ::reedsSheppLength(x, y, phi);
+}
+
+/**
+ * Lengths of the shortest paths from many start poses to one goal. Only the lengths of the word families are evaluated,
+ * no path is built or sampled
+ * @param starts
+ * @param goal
+ * @param dists same size as starts, lengths in meters
+ */
+void ReedsSheppStateSpace::distances(std::span<const Pose<double>> starts,
+                                     const Pose<double>& goal,
+                                     std::span<double> dists) const
+{
+  assert(starts.size() == dists.size());
+  for (size_t idx = 0; idx < starts.size(); ++idx)
+  {
+    double x;
+    double y;
+    double phi;
+    toLocal(starts[idx], goal, x, y, phi);
+    dists[idx] = rho_ * ::reedsSheppLength(x, y, phi);
+  }
 }
 
 ReedsSheppStateSpace::ReedsSheppPath ReedsSheppStateSpace::reedsShepp(const Pose<double>& q_0,
                                                                       const Pose<double>& q_1) const
 {
-  double dx = q_1.x - q_0.x;
-  double dy = q_1.y - q_0.y;
-  double dth = q_1.yaw - q_0.yaw;
-  double c = cos(q_0.yaw);
-  double s = sin(q_0.yaw);
-  double x = c * dx + s * dy;
-  double y = -s * dx + c * dy;
-  return ::reedsShepp(x / rho_, y / rho_, dth);
+  double x;
+  double y;
+  double phi;
+  toLocal(q_0, q_1, x, y, phi);
+  return ::reedsShepp(x, y, phi);
 }
 
 void ReedsSheppStateSpace::type(const Pose<double>& q_0,
@@ -585,15 +644,19 @@ void ReedsSheppStateSpace::type(const Pose<double>& q_0,
   }
 }
 
-ReedsSheppStateSpace::ReedsSheppPath ReedsSheppStateSpace::sample(const Pose<double>& q_0,
-                                                                  const Pose<double>& q_1,
-                                                                  double step_size)
+/**
+ * Shortest path with its segment types and lengths, but without poses
+ * @param q_0
+ * @param q_1
+ * @return
+ */
+ReedsSheppStateSpace::ReedsSheppPath ReedsSheppStateSpace::shortestPath(const Pose<double>& q_0,
+                                                                        const Pose<double>& q_1) const
 {
   ReedsSheppPath path = reedsShepp(q_0, q_1);
-  double dist = rho_ * path.length();
   path.radi = rho_;
 
-  // Store lengths and types for python compatibility
+  // Store lengths in meters and types for python compatibility
   int16_t idx = 0;
   for (auto l : path.length_)
   {
@@ -611,15 +674,44 @@ ReedsSheppStateSpace::ReedsSheppPath ReedsSheppStateSpace::sample(const Pose<dou
       case RS_NOP:
         break;
     }
-    path.lengths.push_back(l);
+    path.lengths.push_back(rho_ * l);
     idx++;
   }
+  return path;
+}
+
+ReedsSheppStateSpace::ReedsSheppPath ReedsSheppStateSpace::sample(const Pose<double>& q_0,
+                                                                  const Pose<double>& q_1,
+                                                                  double step_size) const
+{
+  ReedsSheppPath path = shortestPath(q_0, q_1);
+  sample(q_0, q_1, step_size, path);
+  return path;
+}
 
-  for (double seg = 0.0; seg <= dist; seg += step_size)
+/**
+ * Adds the poses of a path from shortestPath
+ * @param q_0
+ * @param q_1
+ * @param step_size
+ * @param path
+ */
+void ReedsSheppStateSpace::sample(const Pose<double>& q_0,
+                                  const Pose<double>& q_1,
+                                  double step_size,
+                                  ReedsSheppPath& path) const
+{
+  const size_t nb_samples = nbSamples(path, step_size);
+  for (size_t idx = 0; idx < nb_samples; ++idx)
   {
-    //    double qnew[3] = {};
-    interpolate(q_0, path, seg / rho_);
-    //    cb( qnew, user_data);
+    int direction;
+    const Pose<double> pose = interpolate(q_0, path, static_cast<double>(idx) * step_size, direction);
+
+    // Add values to path
+    path.x_list.push_back(pose.x);
+    path.y_list.push_back(pose.y);
+    path.yaw_list.push_back(pose.yaw);
+    path.directions.push_back(direction);
   }
 
   // Add goal pose again
@@ -627,11 +719,31 @@ ReedsSheppStateSpace::ReedsSheppPath ReedsSheppStateSpace::sample(const Pose<dou
   path.y_list.push_back(q_1.y);
   path.yaw_list.push_back(q_1.yaw);
   path.directions.push_back(path.directions.back());
-  return path;
 }
 
-void ReedsSheppStateSpace::interpolate(const Pose<double>& q_0, ReedsSheppPath& path, double seg) const
+/**
+ * Number of poses sample interpolates, the appended goal pose is not included
+ * @param path
+ * @param step_size
+ * @return
+ */
+size_t ReedsSheppStateSpace::nbSamples(const ReedsSheppPath& path, double step_size) const
 {
+  return static_cast<size_t>(rho_ * path.length() / step_size) + 1;
+}
+
+/**
+ * Pose after driving along the path
+ * @param q_0 start of the path
+ * @param path
+ * @param dist driven distance in meters
+ * @param direction driving direction at that pose
+ * @return
+ */
+Pose<double>
+ReedsSheppStateSpace::interpolate(const Pose<double>& q_0, const ReedsSheppPath& path, double dist, int& direction) const
+{
+  double seg = dist / rho_;
   if (seg < 0.0)
   {
     seg = 0.0;
@@ -648,7 +760,7 @@ void ReedsSheppStateSpace::interpolate(const Pose<double>& q_0, ReedsSheppPath&
   pose.x = pose.y = 0.0;
   pose.yaw = q_0.yaw;
 
-  int direction = 1;
+  direction = 1;
 
   for (unsigned int i = 0; i < 5 && seg > 0; ++i)
   {
@@ -688,10 +800,20 @@ void ReedsSheppStateSpace::interpolate(const Pose<double>& q_0, ReedsSheppPath&
 
   pose.x = pose.x * rho_ + q_0.x;
   pose.y = pose.y * rho_ + q_0.y;
+  return pose;
+}
 
-  // Add values to path
-  path.x_list.push_back(pose.x);
-  path.y_list.push_back(pose.y);
-  path.yaw_list.push_back(pose.yaw);
-  path.directions.push_back(direction);
-}
\ No newline at end of file
+void ReedsSheppStateSpace::toLocal(const Pose<double>& q_0,
+                                   const Pose<double>& q_1,
+                                   double& x,
+                                   double& y,
+                                   double& phi) const
+{
+  const double dx = q_1.x - q_0.x;
+  const double dy = q_1.y - q_0.y;
+  const double c = cos(q_0.yaw);
+  const double s = sin(q_0.yaw);
+  x = (c * dx + s * dy) / rho_;
+  y = (-s * dx + c * dy) / rho_;
+  phi = q_1.yaw - q_0.yaw;
+}
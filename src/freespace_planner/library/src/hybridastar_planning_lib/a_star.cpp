@@ -24,7 +24,7 @@ void AStar::initialize(int patch_dim, const Point<double>& patch_origin_utm, con
   //  LOG_DEB("Initialize AStar");
 
   // Patch dimension
-  patch_origin_astar_ = (patch_origin_utm * grid_tf::con2star_).toInt();
+  patch_origin_astar_ = (patch_origin_utm * grid_tf_.con2star_).toInt();
   patch_dim_ = patch_dim;
   unknown_cost_w_ = config["ASTAR_UNKNOWN_COST"].as<double>();
   gm_res_ = config["GM_RES"].as<double>();
@@ -32,6 +32,19 @@ void AStar::initialize(int patch_dim, const Point<double>& patch_origin_utm, con
   astar_dim_ = std::floor(static_cast<double>(patch_dim_) * gm_res_ / astar_res_);
   heuristic_early_exit_ = config["HEURISTIC_EARLY_EXIT"].as<bool>();
   max_extra_nodes_ = config["MAX_EXTRA_NODES_ASTAR"].as<unsigned int>();
+  heuristic_queue_type_ = static_cast<HeuristicQueueType>(config["HEURISTIC_QUEUE"].as<int>());
+  bucket_width_ = config["HEURISTIC_BUCKET_WIDTH"].as<double>();
+  heuristic_incremental_ = config["HEURISTIC_INCREMENTAL"].as<bool>();
+  pooling_backend_ = static_cast<PoolingBackend>(config["POOLING_BACKEND"].as<int>());
+  voronoi_backend_ = static_cast<VoronoiBackend>(config["VORONOI_BACKEND"].as<int>());
+  vor_tile_dim_ = config["VORONOI_TILE_DIM"].as<int>();
+#ifndef USE_CUDA
+  if (pooling_backend_ == POOLING_CUDA)
+  {
+    std::cout << "Built without CUDA, using the CPU pooling backend" << std::endl;
+    pooling_backend_ = POOLING_CPU;
+  }
+#endif
 
   // voronoi potential field
   motion_res_min_ = config["MOTION_RES_MIN"].as<double>();
@@ -41,6 +54,7 @@ void AStar::initialize(int patch_dim, const Point<double>& patch_origin_utm, con
 
   movement_distances_ = getMovementDists();
 
+  vor_coords_.resize(VOR_DIM * VOR_DIM);
   for (size_t y_ind = 0; y_ind < VOR_DIM; ++y_ind)
   {
     for (size_t x_ind = 0; x_ind < VOR_DIM; ++x_ind)
@@ -50,6 +64,7 @@ void AStar::initialize(int patch_dim, const Point<double>& patch_origin_utm, con
     }
   }
 
+  vor_coords_sampling_.resize(VOR_DIM_SAMPLING * VOR_DIM_SAMPLING);
   for (size_t y_ind = 0; y_ind < VOR_DIM_SAMPLING; ++y_ind)
   {
     for (size_t x_ind = 0; x_ind < VOR_DIM_SAMPLING; ++x_ind)
@@ -73,8 +88,14 @@ void AStar::initialize(int patch_dim, const Point<double>& patch_origin_utm, con
 
   init_structs(patch_dim);
 
-  const int pool_dim = std::ceil(grid_tf::star2gm_);
-  Pooling::init(pool_dim);
+  const int pool_dim = std::ceil(grid_tf_.star2gm_);
+  pooling_cpu_.init(pool_dim, config["POOLING_THREADS"].as<size_t>());
+#ifdef USE_CUDA
+  if (pooling_backend_ == POOLING_CUDA)
+  {
+    Pooling::init(pool_dim);
+  }
+#endif
 }
 
 void AStar::init_structs(int patch_dim)
@@ -93,8 +114,12 @@ void AStar::init_structs(int patch_dim)
   obs_y_grad_.resize_and_reset(astar_dim_, astar_dim_, 0.0);
   // motion res map
   motion_res_map_.resize_and_reset(astar_dim_, astar_dim_, motion_res_max_);
+  // nothing of the voronoi field is calculated yet
+  vor_grid_cache_.resize_and_reset(astar_dim_, astar_dim_, VOR_CACHE_UNSEEN);
 
   resetMovementMap();
+
+  guidance_valid_ = false;
 }
 
 void AStar::reinit(const Point<double>& patch_origin_utm, int patch_dim)
@@ -119,17 +144,24 @@ void AStar::reinit(const Point<double>& patch_origin_utm, int patch_dim)
   // motion res map
   util::saveTemp(motion_res_map_, temp_motion_res_map_, motion_res_max_);
   motion_res_map_.resize_and_reset(astar_dim_, astar_dim_, motion_res_max_);
+  // grid the voronoi field tiles were calculated from
+  util::saveTemp(vor_grid_cache_, temp_vor_grid_cache_, VOR_CACHE_UNSEEN);
+  vor_grid_cache_.resize_and_reset(astar_dim_, astar_dim_, VOR_CACHE_UNSEEN);
 
   resetMovementMap();
 
-  const Point<int> next_origin_astar = (patch_origin_utm * grid_tf::con2star_).toInt();
+  const Point<int> next_origin_astar = (patch_origin_utm * grid_tf_.con2star_).toInt();
 
   util::copyPatch2Patch(patch_origin_astar_, next_origin_astar, h_prox_arr_, temp_h_prox_arr_);
   util::copyPatch2Patch(patch_origin_astar_, next_origin_astar, motion_res_map_, temp_motion_res_map_);
   util::copyPatch2Patch(patch_origin_astar_, next_origin_astar, obs_x_grad_, temp_obs_x_grad_);
   util::copyPatch2Patch(patch_origin_astar_, next_origin_astar, obs_y_grad_, temp_obs_y_grad_);
+  util::copyPatch2Patch(patch_origin_astar_, next_origin_astar, vor_grid_cache_, temp_vor_grid_cache_);
 
   patch_origin_astar_ = next_origin_astar;
+
+  // The indices of the guidance heuristic refer to the old patch
+  guidance_valid_ = false;
 }
 
 /**
@@ -146,6 +178,87 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
                                   bool for_path,
                                   bool get_only_near)
 {
+  // The guidance heuristic is repaired where its inputs changed if the goal is the same
+  if (!for_path && !get_only_near && heuristic_incremental_ && repairGuidanceHeuristic(goal_pos, start_pos))
+  {
+    saveGuidanceInputs(goal_pos);
+    return;
+  }
+
+  // To be visited and visited set of nodes, dense on the astar grid
+  NodeDiscGrid* node_grid;
+
+  // Chooses the set of nodes, one for the guidance and one for the path
+  if (for_path)
+  {
+    node_grid = &closed_set_path_;
+  }
+  else
+  {
+    node_grid = &closed_set_guidance_;
+  }
+
+  searchFromGoal(goal_pos, start_pos, get_only_near, *node_grid, frontier_, bucket_frontier_, nodes_near_goal_);
+
+  if (!for_path)
+  {
+    if (get_only_near)
+    {
+      // The search of the nearest nodes overwrote the guidance heuristic
+      guidance_valid_ = false;
+    }
+    else if (heuristic_incremental_)
+    {
+      saveGuidanceInputs(goal_pos);
+    }
+  }
+}
+
+/**
+ * Calculates the guidance heuristic of a goal into the passed buffers. Only reads the grids of the class, so it can be
+ * called for several goals in parallel
+ * @param goal_pos
+ * @param start_pos for early exit
+ * @param buffers
+ */
+void AStar::calcGoalHeuristic(const Point<int>& goal_pos, const Point<int>& start_pos, HeuristicBuffers& buffers) const
+{
+  searchFromGoal(goal_pos,
+                 start_pos,
+                 false,
+                 buffers.node_grid,
+                 buffers.frontier,
+                 buffers.bucket_frontier,
+                 buffers.nodes_near_goal);
+}
+
+/**
+ * Resets the node grid and runs the distance heuristic from the goal with the configured frontier
+ * @param goal_pos
+ * @param start_pos
+ * @param get_only_near
+ * @param node_grid
+ * @param frontier
+ * @param bucket_frontier
+ * @param nodes_near_goal
+ */
+void AStar::searchFromGoal(const Point<int>& goal_pos,
+                           const Point<int>& start_pos,
+                           bool get_only_near,
+                           NodeDiscGrid& node_grid,
+                           IndexedPriorityQueue<size_t, double>& frontier,
+                           BucketQueue<size_t, double>& bucket_frontier,
+                           std::vector<std::pair<double, NodeDisc>>& nodes_near_goal) const
+{
+  node_grid.reset(astar_dim_ * astar_dim_);
+  nodes_near_goal.clear();
+
+  // Goal must be on the grid
+  if (goal_pos.x < 0 || goal_pos.y < 0 || goal_pos.x >= astar_dim_ || goal_pos.y >= astar_dim_)
+  {
+    return;
+  }
+
   // Check if start is unknown
   bool goal_unknown = (astar_grid_(goal_pos) == CollisionChecker::UNKNOWN);
 
@@ -155,33 +268,47 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
   // for early exit
   const NodeDisc start_node = NodeDisc(start_pos, 0.0, 0.0, -1, false);
 
-  const size_t start_id = calcIndex(start_node);
-
-  // To be visited and visited set of nodes
-  std::unordered_map<size_t, NodeDisc> open_set;  // maps indices and nodes
-  std::unordered_map<size_t, NodeDisc>* closed_set;
+  // Add goal node to open set
+  const size_t goal_id = AStar::calcIndex(goal_node);
+  node_grid.open(goal_id, goal_node);
 
-  // Chooses the set of nodes, one for the guidance and one for the path
-  if (for_path)
+  // Expand with the configured frontier
+  if (heuristic_queue_type_ == BUCKET_QUEUE)
   {
-    closed_set = &closed_set_path_;
+    bucket_frontier.reset(bucket_width_);
+    bucket_frontier.put(goal_id, 0);
+    expandDistanceHeuristic(bucket_frontier, node_grid, goal_id, start_node, get_only_near, nodes_near_goal);
   }
   else
   {
-    closed_set = &closed_set_guidance_;
+    frontier.resize(astar_dim_ * astar_dim_);
+    frontier.put(goal_id, 0);
+    expandDistanceHeuristic(frontier, node_grid, goal_id, start_node, get_only_near, nodes_near_goal);
   }
+}
 
-  closed_set->clear();
-  nodes_near_goal_.clear();
-
-  // Add goal node to open set
-  const size_t goal_id = AStar::calcIndex(goal_node);
-  open_set.insert({ goal_id, goal_node });
-
-  // Create priority queue
-  PriorityQueue<size_t, double> frontier;
-  // Add goal node
-  frontier.put(goal_id, 0);
+/**
+ * Expands the distance heuristic from the goal until the frontier is empty or the early exit is reached
+ * @tparam Frontier priority queue, stale entries are skipped
+ * @param frontier contains the goal
+ * @param node_grid contains the goal as open node
+ * @param goal_id
+ * @param start_node
+ * @param get_only_near
+ * @param nodes_near_goal closed nodes near the start if get_only_near is set
+ * @param repair_region if set, the search is restricted to these cells, runs until the frontier is empty and reopens
+ * closed nodes if a cheaper way is found
+ */
+template <typename Frontier>
+void AStar::expandDistanceHeuristic(Frontier& frontier,
+                                    NodeDiscGrid& node_grid,
+                                    size_t goal_id,
+                                    const NodeDisc& start_node,
+                                    bool get_only_near,
+                                    std::vector<std::pair<double, NodeDisc>>& nodes_near_goal,
+                                    const std::vector<uint8_t>* repair_region) const
+{
+  const size_t start_id = calcIndex(start_node);
 
   bool start_found = (start_id == goal_id);
   unsigned int nr_extra_nodes = 0;
@@ -190,7 +317,8 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
   bool is_near = false;
   while (true)
   {
-    if (closed_set->size() > static_cast<size_t>(round((0.95 * (astar_dim_ * astar_dim_)))))
+    if (repair_region == nullptr &&
+        node_grid.nbClosed() > static_cast<size_t>(round((0.95 * (astar_dim_ * astar_dim_)))))
     {
       //      LOG_WARN("Distance heuristic seems to explore too many nodes! "
       //               "This should never happen! The start should be found by the heuristic");
@@ -205,12 +333,9 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
     const size_t c_id = frontier.get();
 
     // if in open set, remove it and put in closed set
-    const auto search_curr = open_set.find(c_id);
-    if (search_curr != open_set.end())
+    if (node_grid.getStatus(c_id) == NodeDiscGrid::OPEN)
     {
-      const NodeDisc current = search_curr->second;
-      open_set.erase(c_id);
-      closed_set->insert({ c_id, current });
+      const NodeDisc current = node_grid.close(c_id);
 
       // goal is to get only near the goal
       if (get_only_near)
@@ -221,7 +346,7 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
 
         if (dist < 10)
         {
-          nodes_near_goal_.emplace_back(dist, current);
+          nodes_near_goal.emplace_back(dist, current);
           is_near = true;
         }
       }
@@ -241,7 +366,7 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
       }
 
       // Allow the lasting open nodes to be explored plus extra nodes, then quit
-      if (heuristic_early_exit_ or get_only_near)
+      if ((heuristic_early_exit_ or get_only_near) && repair_region == nullptr)
       {
         if (start_found || is_near)
         {
@@ -268,27 +393,27 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
         // get index of created node to identify it on grid with one integer
         const size_t n_id = calcIndex(position.x, position.y);
 
-        // If it was already in closed set --> Ignore
-        if (closed_set->contains(n_id))
+        // A repair stays within the cells of the last search
+        if (repair_region != nullptr && !(*repair_region)[n_id])
         {
           continue;
         }
 
-        // new costs caused by movement itself
-        const double movement_weigth = movement_cost_map_(position);
-        const double movement_costs = movement_distances_[i] * movement_weigth;
+        // If it was already in closed set --> Ignore, unless a repair finds a cheaper way
+        const auto status = node_grid.getStatus(n_id);
+        if (status == NodeDiscGrid::CLOSED && repair_region == nullptr)
+        {
+          continue;
+        }
 
         // Track current distance for next heuristic
         const double cost_dist = current.cost_dist_ + movement_distances_[i];
 
-        // new costs caused by proximity to objects
-        const double prox_cost = h_prox_arr_(current.pos) * astar_prox_cost_;
         // costs caused by unknown area
         bool is_unknown = (astar_grid_(current.pos) == CollisionChecker::UNKNOWN);
-        const double unknown_cost = is_unknown ? unknown_cost_w_ : 0;
 
         // New costs up to this node
-        const double current_cost = current.cost_ + movement_costs + prox_cost + unknown_cost;
+        const double current_cost = current.cost_ + calcStepCost(current.pos, i);
 
         // Euclidean heuristic for guidance with lane cost as lowest estimate
         const double h_euclid_dist = astar_lane_movement_cost_ * current.pos.dist2(start_node.pos) * astar_res_;
@@ -299,24 +424,18 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
         const NodeDisc node = NodeDisc(position, current_cost, cost_dist, static_cast<int>(c_id), is_unknown);
 
         // Node is valid, continue the search on the neighbors
-        const auto search_next = open_set.find(n_id);
         // is not in open set
-        if (search_next == open_set.end())
+        if (status == NodeDiscGrid::UNVISITED)
         {
-          open_set.insert({ n_id, node });
+          node_grid.open(n_id, node);
           frontier.put(n_id, estimated_costs);
 
           // Node was already in open set, compare costs and replace it if new costs are lower
         }
-        else
+        else if (node_grid[n_id].cost_ > node.cost_)
         {
-          const NodeDisc found_node = search_next->second;
-          if (found_node.cost_ > node.cost_)
-          {
-            open_set.erase(n_id);
-            open_set.emplace(n_id, node);
-            frontier.put(n_id, estimated_costs);
-          }
+          node_grid.open(n_id, node);
+          frontier.put(n_id, estimated_costs);
         }
       }
       // If not in open set, ignore it, can only happen because of updating nodes with lower costs
@@ -328,6 +447,237 @@ void AStar::calcDistanceHeuristic(const Point<int>& goal_pos,
   }
 }
 
+/**
+ * Costs of a step of the distance heuristic: movement costs of the reached cell, proximity and unknown costs of the
+ * cell it starts from
+ * @param from
+ * @param motion_idx
+ * @return
+ */
+double AStar::calcStepCost(const Point<int>& from, size_t motion_idx) const
+{
+  const Point<int> to = from + motion_[motion_idx];
+  const double movement_costs = movement_distances_[motion_idx] * movement_cost_map_(to);
+  const double prox_cost = h_prox_arr_(from) * astar_prox_cost_;
+  const double unknown_cost = (astar_grid_(from) == CollisionChecker::UNKNOWN) ? unknown_cost_w_ : 0;
+  return movement_costs + prox_cost + unknown_cost;
+}
+
+/**
+ * Stores the inputs of the guidance heuristic to find the changed cells in the next cycle
+ * @param goal_pos
+ */
+void AStar::saveGuidanceInputs(const Point<int>& goal_pos)
+{
+  const size_t nb_cells = static_cast<size_t>(astar_dim_) * astar_dim_;
+  guidance_grid_.assign(astar_grid_.getPtr(), astar_grid_.getPtr() + nb_cells);
+  guidance_prox_.assign(h_prox_arr_.getPtr(), h_prox_arr_.getPtr() + nb_cells);
+  guidance_movement_.assign(movement_cost_map_.getPtr(), movement_cost_map_.getPtr() + nb_cells);
+  guidance_goal_ = goal_pos;
+  guidance_valid_ = true;
+}
+
+/**
+ * Repairs the guidance heuristic of the last cycle instead of computing it from scratch, in the style of LPA*.
+ * The step costs only depend on the A* grid, the proximity and the movement costs of the two cells of a step. All
+ * closed nodes at or next to a changed cell are invalidated together with the nodes whose parent chain passes through
+ * them. The invalidated nodes are seeded again from their valid closed neighbors and the search is continued with
+ * reopening within the closed cells of the last search, so cost decreases propagate as well. The covered area stays
+ * the one of the last search, so the heuristic is recalculated if an occupied cell became traversable or a cell
+ * outside of it became cheaper.
+ * @param goal_pos
+ * @param start_pos
+ * @return false if a full recalculation is necessary
+ */
+bool AStar::repairGuidanceHeuristic(const Point<int>& goal_pos, const Point<int>& start_pos)
+{
+  NodeDiscGrid& node_grid = closed_set_guidance_;
+  const size_t nb_cells = static_cast<size_t>(astar_dim_) * astar_dim_;
+
+  if (!guidance_valid_ || goal_pos.x != guidance_goal_.x || goal_pos.y != guidance_goal_.y ||
+      node_grid.size() != nb_cells || guidance_grid_.size() != nb_cells)
+  {
+    return false;
+  }
+
+  // Find the changed cells
+  const size_t goal_id = calcIndex(goal_pos.x, goal_pos.y);
+  const uint8_t* grid = astar_grid_.getPtr();
+  const double* prox = h_prox_arr_.getPtr();
+  const double* movement = movement_cost_map_.getPtr();
+  std::vector<size_t> changed_cells;
+  for (size_t index = 0; index < nb_cells; ++index)
+  {
+    if (grid[index] != guidance_grid_[index] || prox[index] != guidance_prox_[index] ||
+        movement[index] != guidance_movement_[index])
+    {
+      // A cell that became traversable was never closed, the repair region cannot reach the ways through it.
+      // The same holds for cheaper cells outside of the region
+      const bool became_free = guidance_grid_[index] == CollisionChecker::OCC && grid[index] != CollisionChecker::OCC;
+      const bool became_cheaper =
+          (guidance_grid_[index] == CollisionChecker::UNKNOWN && grid[index] == CollisionChecker::FREE) ||
+          prox[index] < guidance_prox_[index] || movement[index] < guidance_movement_[index];
+      if (became_free || (became_cheaper && node_grid.getStatus(index) != NodeDiscGrid::CLOSED))
+      {
+        return false;
+      }
+      changed_cells.push_back(index);
+    }
+  }
+  // The last search only covers the surroundings of the old start
+  const size_t start_id = calcIndex(start_pos.x, start_pos.y);
+  if (changed_cells.size() > MAX_INCREMENTAL_CHANGE_RATIO * static_cast<double>(nb_cells) ||
+      grid[goal_id] != guidance_grid_[goal_id] || !node_grid.contains(start_id))
+  {
+    return false;
+  }
+  if (changed_cells.empty())
+  {
+    return true;
+  }
+
+  // Closed nodes whose step costs changed
+  enum : uint8_t
+  {
+    UNCHECKED,
+    VALID,
+    INVALID
+  };
+  std::vector<uint8_t> validity(nb_cells, UNCHECKED);
+  validity[goal_id] = VALID;
+  for (const size_t index : changed_cells)
+  {
+    const auto [x_ind, y_ind] = reverse2DIndex(index);
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+      for (int dx = -1; dx <= 1; ++dx)
+      {
+        const int x_nb = static_cast<int>(x_ind) + dx;
+        const int y_nb = static_cast<int>(y_ind) + dy;
+        if (x_nb < 0 || y_nb < 0 || x_nb >= astar_dim_ || y_nb >= astar_dim_)
+        {
+          continue;
+        }
+        const size_t nb_index = calcIndex(x_nb, y_nb);
+        if (nb_index != goal_id && node_grid.getStatus(nb_index) == NodeDiscGrid::CLOSED)
+        {
+          validity[nb_index] = INVALID;
+        }
+      }
+    }
+  }
+
+  // Propagate to the descendants by following the parent chains, the repair stays within the closed cells
+  std::vector<uint8_t> region(nb_cells, 0);
+  std::vector<size_t> chain;
+  for (size_t index = 0; index < nb_cells; ++index)
+  {
+    if (node_grid.getStatus(index) != NodeDiscGrid::CLOSED)
+    {
+      // Open nodes of the last search are not part of the heuristic
+      node_grid.unvisit(index);
+      continue;
+    }
+    region[index] = 1;
+    size_t ancestor = index;
+    while (validity[ancestor] == UNCHECKED)
+    {
+      chain.push_back(ancestor);
+      const int parent = node_grid[ancestor].parent_index_;
+      if (parent < 0 || node_grid.getStatus(parent) != NodeDiscGrid::CLOSED)
+      {
+        validity[ancestor] = INVALID;
+        break;
+      }
+      ancestor = parent;
+    }
+    const uint8_t chain_validity = validity[ancestor];
+    for (const size_t chain_index : chain)
+    {
+      validity[chain_index] = chain_validity;
+    }
+    chain.clear();
+  }
+  for (size_t index = 0; index < nb_cells; ++index)
+  {
+    if (validity[index] == INVALID)
+    {
+      node_grid.unvisit(index);
+    }
+  }
+
+  // Seed the frontier with the invalidated nodes from their valid closed neighbors
+  const NodeDisc start_node = NodeDisc(start_pos, 0.0, 0.0, -1, false);
+  const auto seed = [this, &node_grid, &start_node](auto& frontier, size_t index) {
+    const auto [x_ind, y_ind] = reverse2DIndex(index);
+    const Point<int> position(static_cast<int>(x_ind), static_cast<int>(y_ind));
+    if (!verifyNode(position.x, position.y))
+    {
+      node_grid.unvisit(index);
+      return;
+    }
+
+    std::optional<NodeDisc> best;
+    double best_key = 0;
+    for (size_t i = 0; i < NB_GRID_MOTIONS; ++i)
+    {
+      const Point<int> from = position - motion_[i];
+      if (from.x < 0 || from.y < 0 || from.x >= astar_dim_ || from.y >= astar_dim_)
+      {
+        continue;
+      }
+      const size_t from_id = calcIndex(from.x, from.y);
+      if (node_grid.getStatus(from_id) != NodeDiscGrid::CLOSED)
+      {
+        continue;
+      }
+      const NodeDisc& parent = node_grid[from_id];
+      const double cost = parent.cost_ + calcStepCost(from, i);
+      if (!best || cost < best->cost_)
+      {
+        const bool is_unknown = (astar_grid_(from) == CollisionChecker::UNKNOWN);
+        const double cost_dist = parent.cost_dist_ + movement_distances_[i];
+        best = NodeDisc(position, cost, cost_dist, static_cast<int>(from_id), is_unknown);
+        best_key = cost + astar_lane_movement_cost_ * from.dist2(start_node.pos) * astar_res_;
+      }
+    }
+
+    if (best)
+    {
+      node_grid.open(index, *best);
+      frontier.put(index, best_key);
+    }
+    else
+    {
+      node_grid.unvisit(index);
+    }
+  };
+
+  const auto repair = [&](auto& frontier) {
+    for (size_t index = 0; index < nb_cells; ++index)
+    {
+      if (validity[index] == INVALID)
+      {
+        seed(frontier, index);
+      }
+    }
+    expandDistanceHeuristic(frontier, node_grid, goal_id, start_node, false, nodes_near_goal_, &region);
+  };
+
+  if (heuristic_queue_type_ == BUCKET_QUEUE)
+  {
+    bucket_frontier_.reset(bucket_width_);
+    repair(bucket_frontier_);
+  }
+  else
+  {
+    frontier_.resize(nb_cells);
+    repair(frontier_);
+  }
+
+  return node_grid.contains(start_id);
+}
+
 /**
  * Movement costs == travelled distance
  * @return
@@ -349,7 +699,7 @@ std::array<double, AStar::NB_GRID_MOTIONS> AStar::getMovementDists()
  * @param y_ind
  * @return
  */
-size_t AStar::calcIndex(size_t x_ind, size_t y_ind)
+size_t AStar::calcIndex(size_t x_ind, size_t y_ind) const
 {
   return y_ind * astar_dim_ + x_ind;
 }
@@ -359,7 +709,7 @@ size_t AStar::calcIndex(size_t x_ind, size_t y_ind)
  * @param node
  * @return
  */
-size_t AStar::calcIndex(const NodeDisc& node)
+size_t AStar::calcIndex(const NodeDisc& node) const
 {
   return calcIndex(node.pos.x, node.pos.y);
 }
@@ -371,7 +721,7 @@ size_t AStar::calcIndex(const NodeDisc& node)
  * @param max_idx
  * @return
  */
-bool AStar::verifyNode(int x_ind, int y_ind)
+bool AStar::verifyNode(int x_ind, int y_ind) const
 {
   // node is out of bounds or occupied
   if ((x_ind < 0 || y_ind < 0) || (x_ind >= astar_dim_ || y_ind >= astar_dim_))
@@ -393,23 +743,23 @@ bool AStar::verifyNode(int x_ind, int y_ind)
  * @param heuristic
  * @return
  */
-int AStar::findValidNeighborIndex(int start_idx, std::unordered_map<size_t, NodeDisc> heuristic)
+int AStar::findValidNeighborIndex(int start_idx, const NodeDiscGrid& heuristic)
 {
   int backup_idx = start_idx + 1;
   //  LOG_INF("Checking node to the right");
-  if (heuristic.find(backup_idx) == heuristic.end())
+  if (!heuristic.contains(backup_idx))
   {
     backup_idx = start_idx - 1;
     //    LOG_INF("Checking node to the left");
-    if (heuristic.find(backup_idx) == heuristic.end())
+    if (!heuristic.contains(backup_idx))
     {
       backup_idx = start_idx + astar_dim_;
       //      LOG_INF("Checking node above");
-      if (heuristic.find(backup_idx) == heuristic.end())
+      if (!heuristic.contains(backup_idx))
       {
         backup_idx = start_idx - astar_dim_;
         //        LOG_INF("Checking node below");
-        if (heuristic.find(backup_idx) == heuristic.end())
+        if (!heuristic.contains(backup_idx))
         {
           //          LOG_ERR("No node around the ego/start position was in heuristic, this should never be the case");
           backup_idx = -1;
@@ -435,7 +785,7 @@ std::pair<std::vector<int>, std::vector<int>> AStar::getAstarPath(int x_index, i
   size_t start_idx = calcIndex(x_index, y_index);
 
   // find node in closed set
-  if (closed_set_guidance_.find(start_idx) == closed_set_guidance_.end())
+  if (!closed_set_guidance_.contains(start_idx))
   {
     //    LOG_WARN("Start was not in heuristic! Checking for neighbor!");
     int index = findValidNeighborIndex(static_cast<int>(start_idx), closed_set_guidance_);
@@ -464,13 +814,34 @@ std::pair<std::vector<int>, std::vector<int>> AStar::getAstarPath(int x_index, i
   return { x_list, y_list };
 }
 
+/**
+ * Calculates the voronoi potential field with the configured backend
+ * @param ego_index
+ */
+void AStar::calcVoronoiPotentialField(const Point<int>& ego_index)
+{
+  h_prox_arr_.unshare();
+  obs_x_grad_.unshare();
+  obs_y_grad_.unshare();
+  motion_res_map_.unshare();
+
+  if (voronoi_backend_ == VORONOI_EDT)
+  {
+    calcVoronoiPotentialFieldEdt();
+  }
+  else
+  {
+    calcVoronoiPotentialFieldFortune(ego_index);
+  }
+}
+
 /**
  * * calculate the voronoi potential field around the ego vehicle
  * This consists of getting the obstacles from the astar grid, calculated a voronoi diagram,
  * followed by final calculations
  * @param ego_index
  */
-void AStar::calcVoronoiPotentialField(const Point<int>& ego_index)
+void AStar::calcVoronoiPotentialFieldFortune(const Point<int>& ego_index)
 {
   const auto origin_extract = getCurrentMapOrigin(ego_index, VOR_DIM);
   const auto origin_sampling = getCurrentMapOrigin(ego_index, VOR_DIM_SAMPLING);
@@ -551,7 +922,7 @@ void AStar::calcVoronoiPotentialField(const Point<int>& ego_index)
       std::execution::unseq,
       vor_coords_.begin(),
       vor_coords_.end(),
-      [&origin_extract, &obs_mat_index, &vor_mat_index](const auto& point) {
+      [this, &origin_extract, &obs_mat_index, &vor_mat_index](const auto& point) {
         calcVorFieldElement({ point[0] + origin_extract.x, point[1] + origin_extract.y }, obs_mat_index, vor_mat_index);
       });
 }
@@ -582,9 +953,25 @@ void AStar::calcVorFieldElement(const std::array<double, 2>& query_vec,
   vor_mat_index.index->findNeighbors(resultSet_vor, query_vec.data());
   const double d_v = sqrt(out_dists_sqr_vor[0]);
 
-  const int x_ind = static_cast<int>(query_vec[0]);
-  const int y_ind = static_cast<int>(query_vec[1]);
+  setVorFieldElement(static_cast<int>(query_vec[0]),
+                     static_cast<int>(query_vec[1]),
+                     d_o,
+                     d_v,
+                     query_vec[0] - obs_mat_index.kdtree_get_pt(ret_indexes_obs[0], 0),
+                     query_vec[1] - obs_mat_index.kdtree_get_pt(ret_indexes_obs[0], 1));
+}
 
+/**
+ * Sets the elements of the proximity heuristic, the obstacle gradients and the motion res map of a cell
+ * @param x_ind
+ * @param y_ind
+ * @param d_o distance to the nearest obstacle
+ * @param d_v distance to the nearest voronoi edge
+ * @param obs_dist_x x component of the vector from the nearest obstacle to the cell
+ * @param obs_dist_y y component of the vector from the nearest obstacle to the cell
+ */
+void AStar::setVorFieldElement(int x_ind, int y_ind, double d_o, double d_v, double obs_dist_x, double obs_dist_y)
+{
   // calculate the voronoi potential fields
   double val = 0;
   double dist_x = 0;
@@ -597,8 +984,8 @@ void AStar::calcVorFieldElement(const std::array<double, 2>& query_vec,
     if (d_o != 0)
     {
       // get distance components to next obstacle
-      dist_x = query_vec[0] - obs_mat_index.kdtree_get_pt(ret_indexes_obs[0], 0);
-      dist_y = query_vec[1] - obs_mat_index.kdtree_get_pt(ret_indexes_obs[0], 1);
+      dist_x = obs_dist_x;
+      dist_y = obs_dist_y;
 
       // Invert and normalize that the gradient is longer on close objects
       dist_x = util::sgn(dist_x) * (do_max_ - util::sgn(dist_x) * dist_x) / do_max_;
@@ -623,6 +1010,220 @@ void AStar::calcVorFieldElement(const std::array<double, 2>& query_vec,
   motion_res_map_(y_ind, x_ind) = std::max(motion_res, motion_res_min_);
 }
 
+/**
+ * Calculates the voronoi potential field on the full patch from exact euclidean feature transforms, first of the
+ * obstacles, then of the voronoi edge cells derived from it. Delivers the same fields as the Fortune backend, the
+ * distance to the voronoi diagram is taken to its edges instead of to the vertices of the clipped edges.
+ * With tiles, only the tiles are recalculated whose surroundings changed since the last cycle. A tile is calculated
+ * on a window padded by VOR_TILE_PAD_FACTOR times the largest distance the fields depend on
+ */
+void AStar::calcVoronoiPotentialFieldEdt()
+{
+  const Point<int> patch_min(0, 0);
+  const Point<int> patch_max(astar_dim_, astar_dim_);
+
+  if (vor_tile_dim_ <= 0)
+  {
+    // No obstacles, no vertices, no heuristic!
+    const uint8_t* grid = astar_grid_.getPtr();
+    if (std::none_of(grid, grid + static_cast<size_t>(astar_dim_) * astar_dim_, [](uint8_t cell) {
+          return cell == CollisionChecker::OCC;
+        }))
+    {
+      return;
+    }
+    calcVoronoiWindowEdt(patch_min, patch_max, patch_min, patch_max);
+    return;
+  }
+
+  const int tile_pad = VOR_TILE_PAD_FACTOR * static_cast<int>(std::ceil(std::max(do_max_, dist_val_max_)));
+  markDirtyVoronoiTiles(tile_pad);
+
+  // The padded windows overlap, a mostly dirty patch is faster calculated at once
+  const size_t nb_dirty = std::count(vor_tile_dirty_.begin(), vor_tile_dirty_.end(), 1);
+  if (2 * nb_dirty > vor_tile_dirty_.size())
+  {
+    calcVoronoiWindowEdt(patch_min, patch_max, patch_min, patch_max);
+    return;
+  }
+
+  const int nb_tiles = (astar_dim_ + vor_tile_dim_ - 1) / vor_tile_dim_;
+  for (int y_tile = 0; y_tile < nb_tiles; ++y_tile)
+  {
+    for (int x_tile = 0; x_tile < nb_tiles; ++x_tile)
+    {
+      if (!vor_tile_dirty_[y_tile * nb_tiles + x_tile])
+      {
+        continue;
+      }
+      const Point<int> tile_min(x_tile * vor_tile_dim_, y_tile * vor_tile_dim_);
+      const Point<int> tile_max(std::min(tile_min.x + vor_tile_dim_, astar_dim_),
+                                std::min(tile_min.y + vor_tile_dim_, astar_dim_));
+      const Point<int> window_min(std::max(tile_min.x - tile_pad, 0), std::max(tile_min.y - tile_pad, 0));
+      const Point<int> window_max(std::min(tile_max.x + tile_pad, astar_dim_),
+                                  std::min(tile_max.y + tile_pad, astar_dim_));
+      calcVoronoiWindowEdt(window_min, window_max, tile_min, tile_max);
+    }
+  }
+}
+
+/**
+ * Marks the tiles whose padded window contains cells which changed between occupied and not occupied since the last
+ * cycle. Cells that are new after a patch shift or parameters that changed invalidate the cache as well
+ * @param tile_pad
+ */
+void AStar::markDirtyVoronoiTiles(int tile_pad)
+{
+  const std::array<double, 5> params = { alpha_, do_min_, do_max_, dist_val_min_, dist_val_max_ };
+  const auto [cache_dim, unused] = vor_grid_cache_.getDims();
+  if (cache_dim != astar_dim_ || params != vor_cache_params_)
+  {
+    vor_grid_cache_.resize_and_reset(astar_dim_, astar_dim_, VOR_CACHE_UNSEEN);
+    vor_cache_params_ = params;
+  }
+
+  const int nb_tiles = (astar_dim_ + vor_tile_dim_ - 1) / vor_tile_dim_;
+  vor_tile_dirty_.assign(static_cast<size_t>(nb_tiles) * nb_tiles, 0);
+
+  for (int y_ind = 0; y_ind < astar_dim_; ++y_ind)
+  {
+    for (int x_ind = 0; x_ind < astar_dim_; ++x_ind)
+    {
+      const uint8_t cell = astar_grid_(y_ind, x_ind);
+      const uint8_t cached = vor_grid_cache_(y_ind, x_ind);
+      if (cached != VOR_CACHE_UNSEEN && (cached == CollisionChecker::OCC) == (cell == CollisionChecker::OCC))
+      {
+        continue;
+      }
+      vor_grid_cache_(y_ind, x_ind) = cell;
+
+      const int x_tile_min = std::max(x_ind - tile_pad, 0) / vor_tile_dim_;
+      const int x_tile_max = std::min(x_ind + tile_pad, astar_dim_ - 1) / vor_tile_dim_;
+      const int y_tile_min = std::max(y_ind - tile_pad, 0) / vor_tile_dim_;
+      const int y_tile_max = std::min(y_ind + tile_pad, astar_dim_ - 1) / vor_tile_dim_;
+      for (int y_tile = y_tile_min; y_tile <= y_tile_max; ++y_tile)
+      {
+        std::fill(vor_tile_dirty_.begin() + y_tile * nb_tiles + x_tile_min,
+                  vor_tile_dirty_.begin() + y_tile * nb_tiles + x_tile_max + 1,
+                  1);
+      }
+    }
+  }
+}
+
+/**
+ * Calculates the voronoi potential field of the output cells from the obstacles within a window containing them
+ * @param window_min
+ * @param window_max exclusive
+ * @param out_min
+ * @param out_max exclusive
+ */
+void AStar::calcVoronoiWindowEdt(const Point<int>& window_min,
+                                 const Point<int>& window_max,
+                                 const Point<int>& out_min,
+                                 const Point<int>& out_max)
+{
+  const int x_dim = window_max.x - window_min.x;
+  const int y_dim = window_max.y - window_min.y;
+
+  edt_sites_.resize(static_cast<size_t>(x_dim) * y_dim);
+  for (int y_ind = 0; y_ind < y_dim; ++y_ind)
+  {
+    for (int x_ind = 0; x_ind < x_dim; ++x_ind)
+    {
+      edt_sites_[y_ind * x_dim + x_ind] =
+          static_cast<uint8_t>(astar_grid_(window_min.y + y_ind, window_min.x + x_ind) == CollisionChecker::OCC);
+    }
+  }
+
+  distance_transform_.execute(edt_sites_, x_dim, y_dim, obs_dist_sqr_, obs_nearest_);
+
+  calcVoronoiEdgeCells(x_dim, y_dim);
+  distance_transform_.execute(edt_sites_, x_dim, y_dim, vor_dist_sqr_, vor_nearest_);
+
+  for (int y_ind = out_min.y; y_ind < out_max.y; ++y_ind)
+  {
+    for (int x_ind = out_min.x; x_ind < out_max.x; ++x_ind)
+    {
+      const int x_local = x_ind - window_min.x;
+      const int y_local = y_ind - window_min.y;
+      const size_t index = y_local * x_dim + x_local;
+
+      // Without obstacles in the window the cell is far away from all of them
+      const int obs_index = obs_nearest_[index];
+      if (obs_index == DistanceTransform::NO_SITE)
+      {
+        setVorFieldElement(x_ind, y_ind, std::numeric_limits<double>::infinity(), 0, 0, 0);
+        continue;
+      }
+
+      // Without voronoi edges every cell is treated as far away from them
+      const double d_v = (vor_nearest_[index] == DistanceTransform::NO_SITE) ? std::numeric_limits<double>::max() :
+                                                                                sqrt(vor_dist_sqr_[index]);
+
+      setVorFieldElement(x_ind,
+                         y_ind,
+                         sqrt(obs_dist_sqr_[index]),
+                         d_v,
+                         x_local - obs_index % x_dim,
+                         y_local - obs_index / x_dim);
+    }
+  }
+}
+
+/**
+ * Marks the cells on the voronoi edges in edt_sites_, in the coordinates of the current window. Neighboring free
+ * cells with different nearest obstacles lie on both sides of a voronoi edge, the cell closer to the bisector is
+ * marked. Like in the Fortune backend, edges between obstacles closer than do_min_ are ignored.
+ * @param x_dim
+ * @param y_dim
+ */
+void AStar::calcVoronoiEdgeCells(int x_dim, int y_dim)
+{
+  const double min_site_dist_sqr = do_min_ * do_min_;
+  std::fill(edt_sites_.begin(), edt_sites_.end(), 0);
+
+  const auto dist_sqr = [x_dim](int cell, int site) {
+    const double x_diff = cell % x_dim - site % x_dim;
+    const double y_diff = cell / x_dim - site / x_dim;
+    return x_diff * x_diff + y_diff * y_diff;
+  };
+
+  const auto check_pair = [&](int index, int nb_index) {
+    const int site = obs_nearest_[index];
+    const int nb_site = obs_nearest_[nb_index];
+    if (site == nb_site || obs_dist_sqr_[index] == 0 || obs_dist_sqr_[nb_index] == 0)
+    {
+      return;
+    }
+    if (dist_sqr(site, nb_site) < min_site_dist_sqr)
+    {
+      return;
+    }
+
+    // Distance of both cells to the bisector of the two obstacles, in squared distance differences
+    const double margin = dist_sqr(index, nb_site) - obs_dist_sqr_[index];
+    const double nb_margin = dist_sqr(nb_index, site) - obs_dist_sqr_[nb_index];
+    edt_sites_[margin <= nb_margin ? index : nb_index] = 1;
+  };
+
+  for (int y_ind = 0; y_ind < y_dim; ++y_ind)
+  {
+    for (int x_ind = 0; x_ind < x_dim; ++x_ind)
+    {
+      const int index = y_ind * x_dim + x_ind;
+      if (x_ind + 1 < x_dim)
+      {
+        check_pair(index, index + 1);
+      }
+      if (y_ind + 1 < y_dim)
+      {
+        check_pair(index, index + x_dim);
+      }
+    }
+  }
+}
+
 /**
  * Get 2d index from flattened 1d index
  * @param idx
@@ -635,25 +1236,21 @@ std::pair<size_t, size_t> AStar::reverse2DIndex(size_t idx)
 }
 
 /**
- * return previously calculated proximity heuristic array
+ * return previously calculated obstacle gradient in x as read only view
  * @return
  */
-py::array_t<double> AStar::getObsGradX()
+py::array_t<double> AStar::getObsGradX() const
 {
-  return py::array_t<double>({ astar_dim_, astar_dim_ },  // shape
-                             obs_x_grad_.data().data()    // the data pointer
-  );
+  return obs_x_grad_.getNumpyArr();
 }
 
 /**
- * return previously calculated proximity heuristic array
+ * return previously calculated obstacle gradient in y as read only view
  * @return
  */
-py::array_t<double> AStar::getObsGradY()
+py::array_t<double> AStar::getObsGradY() const
 {
-  return py::array_t<double>({ astar_dim_, astar_dim_ },  // shape
-                             obs_y_grad_.data().data()    // the data pointer
-  );
+  return obs_y_grad_.getNumpyArr();
 }
 
 Point<int> AStar::getCurrentMapOrigin(const Point<int>& ego_pos, size_t dim)
@@ -671,79 +1268,66 @@ std::unordered_map<size_t, NodeDisc> AStar::getDistanceHeuristic(bool for_path)
 {
   if (for_path)
   {
-    return closed_set_path_;
+    return closed_set_path_.getClosedMap();
+  }
+  return closed_set_guidance_.getClosedMap();
+}
+
+/**
+ * return previously calculated heuristic as flat records, e.g. for the visualization
+ * @param for_path
+ * @return buffer of the class, views on it keep it alive
+ */
+std::shared_ptr<const std::vector<NodeDiscRecord>> AStar::getDistanceHeuristicNodes(bool for_path)
+{
+  const NodeDiscGrid& node_grid = for_path ? closed_set_path_ : closed_set_guidance_;
+
+  std::vector<NodeDiscRecord>& records = heuristic_records_.refill();
+  records.reserve(node_grid.nbClosed());
+  for (size_t index = 0; index < node_grid.size(); ++index)
+  {
+    if (node_grid.getStatus(index) == NodeDiscGrid::CLOSED)
+    {
+      const NodeDisc& node = node_grid[index];
+      records.push_back({ index, node.pos.x, node.pos.y, node.cost_, node.parent_index_ });
+    }
   }
-  return closed_set_guidance_;
+  return heuristic_records_.get();
 }
 
+/**
+ * Do a max pooling on the safety patch to receive the astar grid, with the backend selected in the config
+ */
+void AStar::calcAstarGrid()
+{
+  astar_grid_.unshare();
+#ifdef USE_CUDA
+  if (pooling_backend_ == POOLING_CUDA)
+  {
+    calcAstarGridCuda();
+    return;
+  }
+#endif
+  calcAstarGridCpu();
+}
+
+void AStar::calcAstarGridCpu()
+{
+  pooling_cpu_.execute(collision_checker_.patch_safety_arr_.getPtr(),
+                      astar_grid_.getPtr(),
+                      static_cast<int>(patch_dim_),
+                      static_cast<int>(astar_dim_));
+}
+
+#ifdef USE_CUDA
 void AStar::calcAstarGridCuda()
 {
-  Pooling::execute(CollisionChecker::patch_safety_arr_.getPtr(),
+  Pooling::execute(collision_checker_.patch_safety_arr_.getPtr(),
                    astar_grid_.getPtr(),
                    static_cast<int>(patch_dim_),
                    static_cast<int>(astar_dim_));
 }
-
-///**
-// * Do a max pooling on the patch to receive the astar grid
-// */
-// void AStar::calcAstarGrid()
-//{
-//  const size_t patch_dim = CollisionChecker::getPatchDim();
-//  const size_t pool_dim = std::ceil(grid_tf::star2gm);
-//
-//  size_t idx_y_patch;
-//  size_t idx_x_patch;
-//  size_t x_gm_idx;
-//  size_t y_gm_idx;
-//  dtype maximum;
-//  dtype value;
-//
-//  // max pooling
-//  for (size_t y_ind = 0; y_ind < astar_dim_; ++y_ind)
-//  {
-//    for (size_t x_ind = 0; x_ind < astar_dim_; ++x_ind)
-//    {
-//      // Start with minimal value == 0 = FREE
-//      maximum = CollisionChecker::FREE;
-//
-//      // Calculate index in grid map
-//      x_gm_idx = static_cast<size_t>(round(static_cast<double>(x_ind) * grid_tf::star2gm));
-//      y_gm_idx = static_cast<size_t>(round(static_cast<double>(y_ind) * grid_tf::star2gm));
-//
-//      // begin pooling
-//      for (size_t y_shift = 0; y_shift < pool_dim; ++y_shift)
-//      {
-//        // Set and verify y grid index on patch_info
-//        idx_y_patch = y_gm_idx + y_shift;
-//        if (idx_y_patch > patch_dim - 1)
-//        {
-//          continue;
-//        }
-//
-//        for (size_t x_shift = 0; x_shift < pool_dim; ++x_shift)
-//        {
-//          // Set and verify x grid index on patch_info
-//          idx_x_patch = x_gm_idx + x_shift;
-//          if ((idx_x_patch > patch_dim - 1))
-//          {
-//            continue;
-//          }
-//
-//          // get value of collision array for the check on occupied
-//          value = CollisionChecker::getPatchValue(idx_x_patch, idx_y_patch);
-//
-//          // do the actual maximum comparison
-//          if (value > maximum)
-//          {
-//            maximum = value;
-//          }
-//        }
-//      }  // end of pooling
-//      astar_grid_(y_ind, x_ind) = maximum;
-//    }
-//  }
-//}
+#endif
 
 void AStar::resetMovementMap()
 {
@@ -752,6 +1336,7 @@ void AStar::resetMovementMap()
 
 void AStar::setMovementMap(const LaneGraph::edges_t& edges)
 {
+  movement_cost_map_.unshare();
   const std::vector<Point<int>> p_diffs = { { 0, 0 },  { 0, 1 },  { 0, -1 }, { 1, 0 },  { 1, 1 },
                                             { 1, -1 }, { -1, 0 }, { -1, 1 }, { -1, -1 } };
 
@@ -759,12 +1344,12 @@ void AStar::setMovementMap(const LaneGraph::edges_t& edges)
   {
     const auto& [n1_opt, node_center, n3_opt] = edge;
 
-    const Point<int> p_center = (node_center.point_utm_patch * grid_tf::con2star_).toInt();
+    const Point<int> p_center = (node_center.point_utm_patch * grid_tf_.con2star_).toInt();
 
     if (n1_opt)
     {
       auto n_1 = *n1_opt;
-      const Point<int> p_1 = (n_1.point_utm_patch * grid_tf::con2star_).toInt();
+      const Point<int> p_1 = (n_1.point_utm_patch * grid_tf_.con2star_).toInt();
       const std::vector<Point<int>> line1 = util::drawline(p_center, p_1);
 
       for (const auto& point : line1)
@@ -784,7 +1369,7 @@ void AStar::setMovementMap(const LaneGraph::edges_t& edges)
     if (n3_opt)
     {
       auto n_3 = *n3_opt;
-      const Point<int> p_3 = (n_3.point_utm_patch * grid_tf::con2star_).toInt();
+      const Point<int> p_3 = (n_3.point_utm_patch * grid_tf_.con2star_).toInt();
       const std::vector<Point<int>> line2 = util::drawline(p_center, p_3);
 
       for (const auto& point : line2)
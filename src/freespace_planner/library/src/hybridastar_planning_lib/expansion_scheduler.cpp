@@ -0,0 +1,70 @@
+#include "hybridastar_planning_lib/expansion_scheduler.hpp"
+
+/**
+ * @param mode
+ * @param dist_thresh distance to the goal below which expansions are tried
+ * @param seed of the random mode
+ */
+void ExpansionScheduler::configure(Mode mode, double dist_thresh, uint64_t seed)
+{
+  mode_ = mode;
+  dist_thresh_ = dist_thresh;
+  seed_ = seed;
+  reset();
+}
+
+/**
+ * Restarts the decisions and statistics for a new search
+ */
+void ExpansionScheduler::reset()
+{
+  generator_.seed(seed_);
+  distribution_.reset();
+  credit_ = 0;
+  stats_ = Stats();
+}
+
+/**
+ * @param dist2goal heuristic distance of the node to the goal
+ * @return true if the analytic expansions should be tried
+ */
+bool ExpansionScheduler::shouldExpand(double dist2goal)
+{
+  stats_.nb_checks++;
+  const double dist = (dist_thresh_ - dist2goal) / dist_thresh_;
+  const double probability = 0 < dist ? dist : 0;
+
+  bool expand;
+  if (mode_ == CADENCE)
+  {
+    credit_ += probability;
+    expand = credit_ >= 1;
+    if (expand)
+    {
+      credit_ -= 1;
+    }
+  }
+  else
+  {
+    // Drawn for every node like before, so the sequence does not depend on the distances
+    expand = distribution_(generator_) < probability;
+  }
+
+  if (expand)
+  {
+    stats_.nb_attempts++;
+  }
+  return expand;
+}
+
+/**
+ * @param rs_found a collision free Reeds-Shepp path was found
+ * @param ra_found a collision free rear axis path was found
+ * @param time_ms duration of the attempt
+ */
+void ExpansionScheduler::recordAttempt(bool rs_found, bool ra_found, double time_ms)
+{
+  stats_.nb_rs_found += rs_found ? 1 : 0;
+  stats_.nb_ra_found += ra_found ? 1 : 0;
+  stats_.attempt_time_ms += time_ms;
+}
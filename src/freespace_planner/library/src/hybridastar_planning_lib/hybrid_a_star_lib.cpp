@@ -3,6 +3,22 @@
 //
 #include "hybridastar_planning_lib/hybrid_a_star_lib.hpp"
 
+HybridAStar::HybridAStar(const Vehicle& vehicle,
+                         grid_tf& transforms,
+                         CollisionChecker& collision_checker,
+                         Cartographing& cartographing,
+                         AStar& astar,
+                         Smoother& smoother)
+  : vehicle_(vehicle)
+  , grid_tf_(transforms)
+  , collision_checker_(collision_checker)
+  , cartographing_(cartographing)
+  , astar_(astar)
+  , smoother_(smoother)
+  , primitive_cache_(vehicle, collision_checker, transforms)
+{
+}
+
 /**
  * Must be initialized whenever the patch_info size changes
  * @param patch_dim
@@ -23,68 +39,85 @@ void HybridAStar::initialize(int patch_dim, const Point<double>& patch_origin_ut
   //  hybrid_astar::_setLogLevel(log_level);
   //  hybrid_astar::_setShowOrigin(true);
 
-  // Seed for random positions of RS extension
-  int seed = 42;
-  srand(seed);
-
   patch_origin_utm_ = patch_origin_utm;
 
   path2data_ = lib_share_dir + "/data";
 
-  gm_res_ = config["GM_RES"].as<double>();
-  astar_res_ = config["PLANNER_RES"].as<double>();
-  arc_l_ = astar_res_ * 1.5;  // arc length must be longer than the diagonal distance of a cell
+  params_.gm_res = config["GM_RES"].as<double>();
+  params_.astar_res = config["PLANNER_RES"].as<double>();
+  params_.arc_l = params_.astar_res * 1.5;  // arc length must be longer than the diagonal distance of a cell
 
-  astar_yaw_res_deg_ = config["YAW_RES"].as<int>();
-  astar_yaw_res_ = astar_yaw_res_deg_ * util::TO_RAD;
-  astar_yaw_dim_ = 360 / astar_yaw_res_deg_;
-  min_yaw_idx_ = static_cast<int>(round(-util::PI / astar_yaw_res_) - 1);
-  a_star_yaw_res_inv_ = 1 / astar_yaw_res_;
-  steering_inputs_ = calcSteeringInputs();
+  params_.astar_yaw_res_deg = config["YAW_RES"].as<int>();
+  params_.astar_yaw_res = params_.astar_yaw_res_deg * util::TO_RAD;
+  params_.astar_yaw_dim = 360 / params_.astar_yaw_res_deg;
+  params_.min_yaw_idx = static_cast<int>(round(-util::PI / params_.astar_yaw_res) - 1);
+  params_.a_star_yaw_res_inv = 1 / params_.astar_yaw_res;
+  params_.steering_inputs = calcSteeringInputs();
   if (config["ONLY_FORWARD"].as<bool>())
   {
-    direction_inputs_ = { 1, 1 };  // inefficient but is a quickhack for testing anyways
+    params_.direction_inputs = { 1, 1 };  // inefficient but is a quickhack for testing anyways
   }
   else
   {
-    direction_inputs_ = { 1, -1 };
+    params_.direction_inputs = { 1, -1 };
   }
   // As the heuristic becomes smaller, A* turns into Dijkstra’s Algorithm. As the heuristic becomes larger,
   // A* turns into Greedy Best First Search.
-  max_brake_acc_ = config["MAX_BRAKE_ACC"].as<double>();
-  approx_goal_dist2_ = pow(config["APPROX_GOAL_DIST"].as<double>(), 2);
-  approx_goal_angle_rad_ = config["APPROX_GOAL_ANGLE"].as<double>() * util::TO_RAD;
-  waypoint_dist_ = config["WAYPOINT_DIST"].as<int>();
-  waypoint_type_ = static_cast<WaypointType>(config["WAYPOINT_TYPE"].as<int>());
-  dist_thresh_analytic_ = config["DIST_THRESH_ANALYTIC_M"].as<double>();
-  second_rs_steer_factor_ = config["RS_2ND_STEER"].as<double>();
-  extra_steer_cost_analytic_ = config["EXTRA_STEER_COST_ANALYTIC"].as<double>();
-  max_extra_nodes_ = config["MAX_EXTRA_NODES_HASTAR"].as<size_t>();
-  can_turn_on_point_ = Vehicle::is_ushift_;
-  turn_on_point_angle_ = config["TURN_ON_POINT_ANGLE"].as<double>();
-  turn_on_point_horizon_ = config["TURN_ON_POINT_HORIZON"].as<double>();
-  yaw_res_coll_ = config["YAW_RES_COLL"].as<double>();
-  rear_axis_cost_ = config["REAR_AXIS_COST"].as<double>();
-  timeout_ms_ = config["TIMEOUT"].as<int>();
-  motion_res_min_ = config["MOTION_RES_MIN"].as<double>();
-  motion_res_max_ = config["MOTION_RES_MAX"].as<double>();
-  interp_res_ = config["INTERP_RES"].as<double>();
-  rear_axis_freq_ = config["RA_FREQ"].as<int>();
-  non_h_no_obs_patch_dim_ = config["NON_H_NO_OBS_PATCH_DIM"].as<int>();
+  params_.max_brake_acc = config["MAX_BRAKE_ACC"].as<double>();
+  params_.approx_goal_dist2 = pow(config["APPROX_GOAL_DIST"].as<double>(), 2);
+  params_.approx_goal_angle_rad = config["APPROX_GOAL_ANGLE"].as<double>() * util::TO_RAD;
+  params_.waypoint_dist = config["WAYPOINT_DIST"].as<int>();
+  params_.waypoint_type = static_cast<WaypointType>(config["WAYPOINT_TYPE"].as<int>());
+  params_.dist_thresh_analytic = config["DIST_THRESH_ANALYTIC_M"].as<double>();
+  expansion_scheduler_.configure(static_cast<ExpansionScheduler::Mode>(config["EXPANSION_SCHEDULER"].as<int>()),
+                                 params_.dist_thresh_analytic,
+                                 config["EXPANSION_SEED"].as<uint64_t>());
+  params_.second_rs_steer_factor = config["RS_2ND_STEER"].as<double>();
+  params_.extra_steer_cost_analytic = config["EXTRA_STEER_COST_ANALYTIC"].as<double>();
+  params_.max_extra_nodes = config["MAX_EXTRA_NODES_HASTAR"].as<size_t>();
+  params_.can_turn_on_point = vehicle_.is_ushift_;
+  params_.turn_on_point_angle = config["TURN_ON_POINT_ANGLE"].as<double>();
+  params_.turn_on_point_horizon = config["TURN_ON_POINT_HORIZON"].as<double>();
+  params_.yaw_res_coll = config["YAW_RES_COLL"].as<double>();
+  params_.rear_axis_cost = config["REAR_AXIS_COST"].as<double>();
+  params_.timeout_ms = config["TIMEOUT"].as<int>();
+  params_.anytime_inflation_start = config["ANYTIME_INFLATION_START"].as<double>();
+  params_.anytime_inflation_step = config["ANYTIME_INFLATION_STEP"].as<double>();
+  params_.anytime_timeout_ms = config["ANYTIME_TIMEOUT"].as<int>();
+  params_.deadline_check_interval = std::max(config["DEADLINE_CHECK_INTERVAL"].as<size_t>(), size_t(1));
+  params_.partial_path = config["PARTIAL_PATH"].as<bool>();
+  params_.motion_res_min = config["MOTION_RES_MIN"].as<double>();
+  params_.motion_res_max = config["MOTION_RES_MAX"].as<double>();
+  params_.interp_res = config["INTERP_RES"].as<double>();
+  params_.rear_axis_freq = config["RA_FREQ"].as<int>();
+  expansion_pool_.resize(config["NB_EXPANSION_THREADS"].as<size_t>());
+  primitive_cache_.build({ params_.steering_inputs.begin(), params_.steering_inputs.end() },
+                         { params_.direction_inputs.begin(), params_.direction_inputs.end() },
+                         params_.arc_l,
+                         params_.motion_res_min,
+                         params_.motion_res_max,
+                         config["PRIMITIVE_RES_BUCKETS"].as<size_t>(),
+                         params_.yaw_res_coll * util::TO_RAD);
+  primitive_cache_.setFootprintPhases(config["FOOTPRINT_PHASES"].as<size_t>());
+  params_.non_h_no_obs_patch_dim = config["NON_H_NO_OBS_PATCH_DIM"].as<int>();
+  params_.nonh_table_type = config["NONH_TABLE_TYPE"].as<int>();
+  params_.nonh_table_threads = config["NONH_TABLE_THREADS"].as<size_t>();
+  params_.nonh_table_symmetric = config["NONH_TABLE_SYMMETRIC"].as<bool>();
   if (!non_h_no_obs_calculated_)
   {
     calculateNonhnoobs();
   }
 
-  grid_tf::updateTransforms(gm_res_, astar_res_, patch_origin_utm_);
+  grid_tf_.updateTransforms(params_.gm_res, params_.astar_res, patch_origin_utm_);
 
-  AStar::initialize(patch_dim, patch_origin_utm, path2config);
-  CollisionChecker::initialize(patch_dim, path2config);
+  astar_.initialize(patch_dim, patch_origin_utm, path2config);
+  smoother_.init();
+  collision_checker_.initialize(patch_dim, path2config);
   updateLaneGraph(patch_origin_utm, patch_dim);
 
-  if (is_sim_)
+  if (params_.is_sim)
   {
-    Cartographing::resetPatch(patch_dim);
+    cartographing_.resetPatch(patch_dim);
   }
 }
 
@@ -96,26 +129,53 @@ void HybridAStar::reinit(const Point<double>& patch_origin_utm, int patch_dim)
 {
   patch_origin_utm_ = patch_origin_utm;
 
-  grid_tf::updateTransforms(gm_res_, astar_res_, patch_origin_utm_);
+  grid_tf_.updateTransforms(params_.gm_res, params_.astar_res, patch_origin_utm_);
 
-  AStar::reinit(patch_origin_utm, patch_dim);
-  CollisionChecker::resetPatch(patch_dim);
+  astar_.reinit(patch_origin_utm, patch_dim);
+  collision_checker_.resetPatch(patch_dim);
 
   updateLaneGraph(patch_origin_utm, patch_dim);
 
-  if (is_sim_)
+  if (params_.is_sim)
   {
-    Cartographing::resetPatch(patch_dim);
+    cartographing_.resetPatch(patch_dim);
   }
 }
 
+/**
+ * Takes over the parameters of a planner on the same modules and reads its primitives and non-holonomic table instead
+ * of building own ones. Lets several searches run on one environment, must be repeated whenever the planner changed
+ * @param planner
+ */
+void HybridAStar::shareEnvironment(HybridAStar& planner)
+{
+  path2data_ = planner.path2data_;
+  patch_origin_utm_ = planner.patch_origin_utm_;
+  params_ = planner.params_;
+
+  non_h_no_obs_calculated_ = planner.non_h_no_obs_calculated_;
+  expansion_scheduler_ = planner.expansion_scheduler_;
+
+  switch_cost_ = planner.switch_cost_;
+  steer_cost_ = planner.steer_cost_;
+  steer_change_cost_ = planner.steer_change_cost_;
+  h_dist_cost_ = planner.h_dist_cost_;
+  back_cost_ = planner.back_cost_;
+  h_prox_cost_ = planner.h_prox_cost_;
+
+  // The footprints are only read by the searches, so they are brought up to date before
+  planner.primitive_cache_.updateFootprints();
+  primitives_ = planner.primitives_;
+  nonh_table_ = planner.nonh_table_;
+}
+
 /**
  * Calculates the steering inputs depending on the maximum steering angle and the number of steers
  * @return
  */
 std::array<double, HybridAStar::NB_STEER> HybridAStar::calcSteeringInputs()
 {
-  double delta_steer = (2 * Vehicle::max_steer_) / static_cast<double>(NB_STEER - 1);
+  double delta_steer = (2 * vehicle_.max_steer_) / static_cast<double>(NB_STEER - 1);
   std::array<double, HybridAStar::NB_STEER> steering_inputs;
 
   int n_steer_side = static_cast<int>(floor(NB_STEER / 2));
@@ -138,8 +198,19 @@ std::array<double, HybridAStar::NB_STEER> HybridAStar::calcSteeringInputs()
  */
 size_t HybridAStar::calculateIndex(size_t x_index, size_t y_index, int yaw_index)
 {
-  return static_cast<size_t>(yaw_index - min_yaw_idx_) * (AStar::astar_dim_) * (AStar::astar_dim_) +
-         y_index * (AStar::astar_dim_) + x_index;
+  return static_cast<size_t>(yaw_index - params_.min_yaw_idx) * (astar_.astar_dim_) * (astar_.astar_dim_) +
+         y_index * (astar_.astar_dim_) + x_index;
+}
+
+/**
+ * Number of states that can be addressed by calculateIndex.
+ * The yaw index is rounded, so it lies within [params_.min_yaw_idx + 1, -params_.min_yaw_idx - 1]
+ * @return
+ */
+size_t HybridAStar::getNbStates()
+{
+  const auto nb_yaw_indices = static_cast<size_t>(-2 * params_.min_yaw_idx);
+  return nb_yaw_indices * astar_.astar_dim_ * astar_.astar_dim_;
 }
 
 /**
@@ -150,8 +221,8 @@ size_t HybridAStar::calculateIndex(size_t x_index, size_t y_index, int yaw_index
  */
 bool HybridAStar::verifyIndex(int x_index, int y_index)
 {
-  return (-1 < x_index && x_index < static_cast<int>(AStar::astar_dim_)) and
-         (-1 < y_index && y_index < static_cast<int>(AStar::astar_dim_));
+  return (-1 < x_index && x_index < static_cast<int>(astar_.astar_dim_)) and
+         (-1 < y_index && y_index < static_cast<int>(astar_.astar_dim_));
 }
 
 /**
@@ -169,7 +240,7 @@ double HybridAStar::getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybr
   // check if vehicle is inside the patch_info! Verify only the smallest euclidian distance (width/2) == circular around
   int x_diff = goal_node.x_index - start_node.x_index;
   int y_diff = goal_node.y_index - start_node.y_index;
-  double max_dist = pow(non_h_no_obs_patch_dim_ / 2, 2);
+  double max_dist = pow(params_.non_h_no_obs_patch_dim / 2, 2);
   double dist = pow(x_diff, 2) + pow(y_diff, 2);
 
   if (dist > max_dist)
@@ -178,7 +249,7 @@ double HybridAStar::getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybr
   }
 
   // Calculate indices on patch_info
-  int middle_index = static_cast<int>((non_h_no_obs_patch_dim_ - 1)) / 2;
+  int middle_index = static_cast<int>((params_.non_h_no_obs_patch_dim - 1)) / 2;
   int x_idx_s_patch = middle_index - x_diff;
   int y_idx_s_patch = middle_index - y_diff;
   int x_idx_g_patch = middle_index;
@@ -188,14 +259,14 @@ double HybridAStar::getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybr
 
   // get angle diff in indices
   int yaw_idx_diff = start_node.yaw_index - goal_node.yaw_index;
-  if (yaw_idx_diff < min_yaw_idx_)
+  if (yaw_idx_diff < params_.min_yaw_idx)
   {
-    yaw_idx_diff += static_cast<int>(astar_yaw_dim_);
+    yaw_idx_diff += static_cast<int>(params_.astar_yaw_dim);
   }
-  yaw_idx_diff = static_cast<int>(yaw_idx_diff - min_yaw_idx_) % astar_yaw_dim_ + min_yaw_idx_;
+  yaw_idx_diff = static_cast<int>(yaw_idx_diff - params_.min_yaw_idx) % params_.astar_yaw_dim + params_.min_yaw_idx;
 
-  //  double angle_diff = yaw_idx_diff * astar_yaw_res_;
-  double goal_angle = goal_node.yaw_index * astar_yaw_res_;
+  //  double angle_diff = yaw_idx_diff * params_.astar_yaw_res;
+  double goal_angle = goal_node.yaw_index * params_.astar_yaw_res;
   //  LOG_INF("Angle diff in indices is " << yaw_idx_diff);
   //  LOG_INF("This is an angle of ~= " << angle_diff * util::TO_DEGREES);
 
@@ -220,11 +291,26 @@ double HybridAStar::getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybr
   //  LOG_INF("X is " << x_idx_s_patch);
   //  LOG_INF("Y is " << y_idx_s_patch);
 
-  int yaw_idx = yaw_idx_diff - min_yaw_idx_;
+  int yaw_idx = yaw_idx_diff - params_.min_yaw_idx;
   //  LOG_INF("Yaw idx is " << yaw_idx);
 
   //  DebugHelper::show_3d_vec_slice("Current patch_info", non_h_no_obs_, yaw_idx);
-  return non_h_no_obs_(yaw_idx, y_idx_s_patch, x_idx_s_patch);
+  return (*nonh_table_)(yaw_idx, y_idx_s_patch, x_idx_s_patch);
+}
+
+/**
+ * Read-only view on the non-holonomic heuristic table, indexed with [yaw, y, x]. The symmetric layout only
+ * contains the quadrant with non-negative coordinates relative to the goal, float16 tables are returned as float16.
+ * The view shares the table memory, so it stays valid when the planner is initialized again
+ * @return
+ */
+py::array HybridAStar::getNonhnoobsTable() const
+{
+  const py::ssize_t stored_dim = nonh_table_->getStoredDim();
+  const std::vector<py::ssize_t> shape{ nonh_table_->getYawDim(), stored_dim, stored_dim };
+  return numpyView(py::dtype(nonh_table_->getValueType() == NonhTable::FLOAT16 ? "float16" : "float32"),
+                   shape,
+                   nonh_table_->sharedData());
 }
 
 /**
@@ -236,24 +322,21 @@ double HybridAStar::getNonhnoobsVal(const NodeHybrid& start_node, const NodeHybr
  * @param h_dp
  * @return
  */
-double HybridAStar::calcCost(const NodeHybrid& node,
-                             const NodeHybrid& goal_node,
-                             const std::unordered_map<size_t, NodeDisc>& h_dp)
+double HybridAStar::calcCost(const NodeHybrid& node, const NodeHybrid& goal_node, const NodeDiscGrid& h_dp)
 {  // Calculate index of 2D node and check if it is within the calculated heuristic
-  const size_t ind = AStar::calcIndex(node.x_index, node.y_index);
-  auto search_result = h_dp.find(ind);
-  if (search_result == h_dp.end())
+  const size_t ind = astar_.calcIndex(node.x_index, node.y_index);
+  if (!h_dp.contains(ind))
   {
     return OUT_OF_HEURISTIC;
   }
   // estimated cost from current node to goal from distance heuristic and non-holonomic no obstacle heuristic
-  //  const double h_dist = search_result->second.cost_dist_;
-  const double h_dist = search_result->second.cost_;
+  //  const double h_dist = h_dp[ind].cost_dist_;
+  const double h_dist = h_dp[ind].cost_;
 
   // get nonh no obs cost
   const double h_non_h_no_obs = getNonhnoobsVal(node, goal_node);
 
-  const double heuristic_cost = std::max(h_dist, h_non_h_no_obs) * h_dist_cost_;
+  const double heuristic_cost = std::max(h_dist, h_non_h_no_obs) * h_dist_cost_ * inflation_;
 
   return heuristic_cost + node.cost;
 }
@@ -279,7 +362,7 @@ bool HybridAStar::anglesApproxEqual02Pi(double angle1, double angle2)
     angle_diff = abs(angle_diffs.second);
   }
 
-  return angle_diff < approx_goal_angle_rad_;
+  return angle_diff < params_.approx_goal_angle_rad;
 }
 
 /**
@@ -293,15 +376,15 @@ double HybridAStar::getProxOfCorners(const Pose<double>& point)
   const double sin_yaw = sin(point.yaw);
 
   const Point<double> offset(point.x, point.y);
-  const Point<double> f_r = Vehicle::f_r_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
-  const Point<double> f_l = Vehicle::f_l_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
-  const Point<double> r_r = Vehicle::r_r_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
-  const Point<double> r_l = Vehicle::r_l_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
+  const Point<double> f_r = vehicle_.f_r_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
+  const Point<double> f_l = vehicle_.f_l_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
+  const Point<double> r_r = vehicle_.r_r_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
+  const Point<double> r_l = vehicle_.r_l_corner_.rotatePreCalc(cos_yaw, sin_yaw) + offset;
 
-  const double v_1 = util::getBilinInterp(f_r.x, f_r.y, AStar::h_prox_arr_);
-  const double v_2 = util::getBilinInterp(f_l.x, f_l.y, AStar::h_prox_arr_);
-  const double v_3 = util::getBilinInterp(r_r.x, r_r.y, AStar::h_prox_arr_);
-  const double v_4 = util::getBilinInterp(r_l.x, r_l.y, AStar::h_prox_arr_);
+  const double v_1 = util::getBilinInterp(f_r.x, f_r.y, astar_.h_prox_arr_);
+  const double v_2 = util::getBilinInterp(f_l.x, f_l.y, astar_.h_prox_arr_);
+  const double v_3 = util::getBilinInterp(r_r.x, r_r.y, astar_.h_prox_arr_);
+  const double v_4 = util::getBilinInterp(r_l.x, r_l.y, astar_.h_prox_arr_);
 
   const double max_value = std::max({ v_1, v_2, v_3, v_4 });
 
@@ -346,7 +429,7 @@ double HybridAStar::getPathCosts(int x_ind,
 
   // Update costs to reach the new node. Consists of costs of previous costs, including additional costs caused by
   // steering and the travelled distance, denoted by the arc length
-  const double movement_weigth = AStar::movement_cost_map_(y_ind, x_ind);
+  const double movement_weigth = astar_.movement_cost_map_(y_ind, x_ind);
 
   double distance_cost;
   if (direction == -1)
@@ -358,8 +441,8 @@ double HybridAStar::getPathCosts(int x_ind,
     distance_cost = arc_l * movement_weigth;
   }
 
-  const Pose<double> pose = { node.x_list.back(), node.y_list.back(), yaw };
-  const double prox_cost = getProxOfCorners(pose * grid_tf::con2star_) * h_prox_cost_ * arc_l;
+  const Pose<double> pose = { node.pose.x, node.pose.y, yaw };
+  const double prox_cost = getProxOfCorners(pose * grid_tf_.con2star_) * h_prox_cost_ * arc_l;
 
   double movement_cost = control_cost + distance_cost + prox_cost;
 
@@ -378,18 +461,18 @@ std::optional<NodeHybrid> HybridAStar::calcRearAxisNode(const NodeHybrid& node,
   double arc_l = 1.0;  // artificial length to scale costs
 
   // Move vehicle on motion primitive
-  const Pose<double> state{ node.x_list.back(), node.y_list.back(), node.yaw_list.back() };
-  const MotionPrimitive motion_primitive = Vehicle::turn_on_rear_axis(state, delta_angle, yaw_res_coll_);
+  const Pose<double>& state = node.pose;
+  const MotionPrimitive motion_primitive = vehicle_.turn_on_rear_axis(state, delta_angle, params_.yaw_res_coll);
 
   // Check if car collided
-  if (!CollisionChecker::checkPathCollision(
+  if (!collision_checker_.checkPathCollision(
           motion_primitive.x_list_, motion_primitive.y_list_, motion_primitive.yaw_list_))
   {
     return {};
   }
 
   // remove element from collision_indices
-  //  reachable_indices_.insert(AStar::calcIndex(node.x_index, node.y_index));
+  //  reachable_indices_.insert(astar_.calcIndex(node.x_index, node.y_index));
 
   // Calculate discrete coordinates of reached position to set the reached node
   const int direction = motion_primitive.dir_list_[0];
@@ -404,23 +487,23 @@ std::optional<NodeHybrid> HybridAStar::calcRearAxisNode(const NodeHybrid& node,
   // Node costs until here
   const double cost = node.cost + movement_cost;
 
-  // distribute costs over number of steps with given motion inputs to truncate costs when path is driven along later
-  const int nb_elements = static_cast<int>(motion_primitive.nb_elements_);
-  std::vector<double> cont_cost_list(nb_elements, movement_cost / static_cast<double>(nb_elements));
-
-  // Set type of path segment
-  std::vector<PATH_TYPE> types(nb_elements, PATH_TYPE::REAR_AXIS);
+  // Store poses in the neighbor arena, they are only copied to the search if the node is added to the open set
+  const TrajSegment traj = neighbor_traj_.append(motion_primitive.x_list_,
+                                                 motion_primitive.y_list_,
+                                                 motion_primitive.yaw_list_,
+                                                 motion_primitive.dir_list_,
+                                                 PATH_TYPE::REAR_AXIS);
+  const Pose<double> last_pose = {
+    motion_primitive.x_list_.back(), motion_primitive.y_list_.back(), motion_primitive.yaw_list_.back()
+  };
 
   auto parent_idx = static_cast<int64_t>(calculateIndex(node.x_index, node.y_index, node.yaw_index));
   return { { disc_pose.x,
              disc_pose.y,
              disc_pose.yaw,
              direction,
-             motion_primitive.dir_list_,
-             motion_primitive.x_list_,
-             motion_primitive.y_list_,
-             motion_primitive.yaw_list_,
-             types,
+             traj,
+             last_pose,
              0,
              parent_idx,
              cost,
@@ -435,29 +518,41 @@ std::optional<NodeHybrid> HybridAStar::calcRearAxisNode(const NodeHybrid& node,
 Pose<int> HybridAStar::mapCont2Disc(const MotionPrimitive& motion_primitive)
 {
   // Calculate discrete coordinates of reached position to set the reached node
-  const int x_ind = static_cast<int>(motion_primitive.x_list_.back() * grid_tf::con2star_);
-  const int y_ind = static_cast<int>(motion_primitive.y_list_.back() * grid_tf::con2star_);
-  const int yaw_ind = static_cast<int>(round(motion_primitive.yaw_list_.back() * a_star_yaw_res_inv_));
+  const int x_ind = static_cast<int>(motion_primitive.x_list_.back() * grid_tf_.con2star_);
+  const int y_ind = static_cast<int>(motion_primitive.y_list_.back() * grid_tf_.con2star_);
+  const int yaw_ind = static_cast<int>(round(motion_primitive.yaw_list_.back() * params_.a_star_yaw_res_inv));
   return { x_ind, y_ind, yaw_ind };
 }
 
 /**
  * Get next node by epanding the current motion primitive
  * @param node
- * @param steer
- * @param direction
+ * @param control_idx steer_idx * NB_DIR + dir_idx
  * @param motion_res
+ * @param arc_len
+ * @param traj_out arena the poses of the primitive are appended to
  * @return
  */
 std::optional<NodeHybrid>
-HybridAStar::calcNextNode(const NodeHybrid& node, double steer, int direction, double motion_res, double arc_len)
+HybridAStar::calcNextNode(const NodeHybrid& node,
+                          size_t control_idx,
+                          double motion_res,
+                          double arc_len,
+                          TrajectoryArena& traj_out)
 {
+  const double steer = params_.steering_inputs[control_idx / NB_DIR];
+  const int direction = params_.direction_inputs[control_idx % NB_DIR];
+
   // Move the car in continuous coordinates for a specific arc length
   // Generate motion primitives, Move car some steps
-  const double yaw = node.yaw_list.back();
-  const Pose<double> pose{ node.x_list.back(), node.y_list.back(), yaw };
+  const double yaw = node.pose.yaw;
+  const Pose<double>& pose = node.pose;
 
-  const MotionPrimitive motion_primitive = Vehicle::move_car_some_steps(pose, arc_len, motion_res, direction, steer);
+  const bool is_cached = primitives_->enabled();
+  const size_t res_bucket = is_cached ? primitives_->getResBucket(motion_res) : 0;
+  const MotionPrimitive motion_primitive =
+      is_cached ? primitives_->apply(pose, control_idx, res_bucket) :
+                  vehicle_.move_car_some_steps(pose, arc_len, motion_res, direction, steer);
 
   // Get discrete pose
   const Pose<int> disc_pose = mapCont2Disc(motion_primitive);
@@ -469,8 +564,15 @@ HybridAStar::calcNextNode(const NodeHybrid& node, double steer, int direction, d
   }
 
   // Check if car collided
-  if (!CollisionChecker::checkPathCollision(
-          motion_primitive.x_list_, motion_primitive.y_list_, motion_primitive.yaw_list_))
+  if (primitives_->footprintsEnabled())
+  {
+    if (!primitives_->checkFootprint(pose, control_idx, res_bucket))
+    {
+      return {};
+    }
+  }
+  else if (!collision_checker_.checkPathCollision(
+               motion_primitive.x_list_, motion_primitive.y_list_, motion_primitive.yaw_list_))
   {
     return {};
   }
@@ -481,26 +583,24 @@ HybridAStar::calcNextNode(const NodeHybrid& node, double steer, int direction, d
   // Accumulate costs up to this node
   const double cost = node.cost + path_cost;
 
-  // distribute costs over number of steps with given motion inputs to truncate costs when path is driven along later
-  const size_t nb_elements = motion_primitive.nb_elements_;
-  //  std::vector<double> cont_cost_list(nb_elements, path_cost / static_cast<double>(nb_elements));
-
-  const std::vector<int> directions(nb_elements, direction);
-
   const auto parent_index = static_cast<int64_t>(calculateIndex(node.x_index, node.y_index, node.yaw_index));
 
-  // Set type of path segment
-  const std::vector<PATH_TYPE> types(nb_elements, PATH_TYPE::HASTAR);
+  // Store poses in the neighbor arena, they are only copied to the search if the node is added to the open set
+  const TrajSegment traj = traj_out.append(motion_primitive.x_list_,
+                                           motion_primitive.y_list_,
+                                           motion_primitive.yaw_list_,
+                                           motion_primitive.dir_list_,
+                                           PATH_TYPE::HASTAR);
+  const Pose<double> last_pose = {
+    motion_primitive.x_list_.back(), motion_primitive.y_list_.back(), motion_primitive.yaw_list_.back()
+  };
 
   return { { disc_pose.x,
              disc_pose.y,
              disc_pose.yaw,
              direction,
-             directions,
-             motion_primitive.x_list_,
-             motion_primitive.y_list_,
-             motion_primitive.yaw_list_,
-             types,
+             traj,
+             last_pose,
              steer,
              parent_index,
              cost,
@@ -518,27 +618,45 @@ void HybridAStar::setNeighbors(const NodeHybrid& current, std::vector<NodeHybrid
 {
   neighbors_.clear();
   neighbors_.reserve(NB_CONTROLS);
+  neighbor_traj_.reset();
 
-  // iterate through steering inputs
-  std::for_each(std::execution::unseq,
-                steering_inputs_.begin(),
-                steering_inputs_.end(),
-                [&current, &motion_res, &neighbors](auto steer) {
-                  for (int direction : direction_inputs_)
-                  {
-                    // Node is valid
-                    if (auto next_node = calcNextNode(current, steer, direction, motion_res, arc_l_))
-                    {
-                      neighbors.push_back(std::move(*next_node));
-                    }
-                  }
-                });
-
-  if (can_turn_on_point_)
+  if (expansion_pool_.size() <= 1)
+  {
+    // iterate through steering inputs and directions
+    for (size_t control_idx = 0; control_idx < NB_CONTROLS; ++control_idx)
+    {
+      // Node is valid
+      if (auto next_node = calcNextNode(current, control_idx, motion_res, params_.arc_l, neighbor_traj_))
+      {
+        neighbors.push_back(std::move(*next_node));
+      }
+    }
+  }
+  else
+  {
+    // Every control writes into its own slot, so the threads do not share any output
+    expansion_pool_.parallelFor(NB_CONTROLS, [this, &current, motion_res](size_t control_idx) {
+      control_traj_[control_idx].reset();
+      control_nodes_[control_idx] =
+          calcNextNode(current, control_idx, motion_res, params_.arc_l, control_traj_[control_idx]);
+    });
+
+    // Merge in control order to get the same neighbors as the serial expansion
+    for (size_t control_idx = 0; control_idx < NB_CONTROLS; ++control_idx)
+    {
+      if (auto& next_node = control_nodes_[control_idx])
+      {
+        next_node->traj = neighbor_traj_.append(control_traj_[control_idx], next_node->traj);
+        neighbors.push_back(std::move(*next_node));
+      }
+    }
+  }
+
+  if (params_.can_turn_on_point)
   {
     // TODO (Schumann) compare distance heuristic by nonh no obs heuristic
-    const double turn_on_point_angle_rad = turn_on_point_angle_ * util::TO_RAD;
-    if (closed_set_.size() % rear_axis_freq_ == 0)
+    const double turn_on_point_angle_rad = params_.turn_on_point_angle * util::TO_RAD;
+    if (node_pool_.nbClosed() % params_.rear_axis_freq == 0)
     {
       // try turning by degree steps
       for (double delta_angle = -2 * util::PI + turn_on_point_angle_rad;
@@ -585,7 +703,7 @@ double HybridAStar::getTurnCost(double delta_angle)
 {
   delta_angle = abs(delta_angle);
   double pi_diff_cost = (std::abs(util::PI - delta_angle) + 0.5 * delta_angle - util::PI / 2) / util::PI;
-  return rear_axis_cost_ * (1 + pi_diff_cost);
+  return params_.rear_axis_cost * (1 + pi_diff_cost);
 }
 
 /**
@@ -614,7 +732,7 @@ double HybridAStar::getRAPathCosts(ReedsSheppStateSpace::ReedsSheppPath path)
   for (unsigned int i = 0; i < path.x_list.size(); ++i)
   {
     const Pose<double> pose = { path.x_list[i], path.y_list[i], path.yaw_list[i] };
-    prox_cost += getProxOfCorners(pose * grid_tf::con2star_) * h_prox_cost_ * interp_res_;
+    prox_cost += getProxOfCorners(pose * grid_tf_.con2star_) * h_prox_cost_ * params_.interp_res;
   }
   cost += prox_cost;
 
@@ -634,7 +752,7 @@ double HybridAStar::getRAPathCosts(ReedsSheppStateSpace::ReedsSheppPath path)
 double HybridAStar::getRSPathCosts(ReedsSheppStateSpace::ReedsSheppPath path)
 {
   double cost = 0;
-  const double max_steer = atan(Vehicle::w_b_ / path.radi);
+  const double max_steer = atan(vehicle_.w_b_ / path.radi);
   // length cost
   for (auto length : path.lengths)
   {
@@ -663,7 +781,7 @@ double HybridAStar::getRSPathCosts(ReedsSheppStateSpace::ReedsSheppPath path)
   {
     if (ctype != 'S')
     {
-      cost += extra_steer_cost_analytic_ * steer_cost_ * abs(max_steer) * abs(path.lengths[idx_ctype]);
+      cost += params_.extra_steer_cost_analytic * steer_cost_ * abs(max_steer) * abs(path.lengths[idx_ctype]);
     }
     idx_ctype++;
   }
@@ -696,101 +814,61 @@ double HybridAStar::getRSPathCosts(ReedsSheppStateSpace::ReedsSheppPath path)
   for (unsigned int i = 0; i < path.x_list.size(); ++i)
   {
     const Pose<double> pose = { path.x_list[i], path.y_list[i], path.yaw_list[i] };
-    prox_cost += getProxOfCorners(pose * grid_tf::con2star_) * h_prox_cost_ * interp_res_;
+    prox_cost += getProxOfCorners(pose * grid_tf_.con2star_) * h_prox_cost_ * params_.interp_res;
   }
   cost += prox_cost;
 
   return cost;
 }
 
-/**
- * Get path from Reed Shepp extension
- * @param start
- * @param goal
- * @param step_size
- * @param rho
- * @return
- */
-ReedsSheppStateSpace::ReedsSheppPath
-HybridAStar::getReedSheppPath(const Pose<double>& start, const Pose<double>& goal, double step_size, double rho)
-{
-  auto rss = ReedsSheppStateSpace(rho);
-  auto path = rss.sample(start, goal, step_size);
-
-  // update length to real one
-  // TODO (Schumann) Why is the sum of the sub lengths even wrong? This must be a bug in OMPL
-  recalculateLength(path);
-
-  return path;
-}
-
 /**
  * Return final path from the list of nodes
  * @return
  */
-Path HybridAStar::getFinalPath(const NodeHybrid& final_node, const std::unordered_map<size_t, NodeHybrid>& closet_set)
-{
-  // get lists
-  std::vector<double> reversed_x = final_node.x_list;
-  std::vector<double> reversed_y = final_node.y_list;
-  std::vector<double> reversed_yaw = final_node.yaw_list;
-  std::vector<int> reversed_direct_cont = final_node.dir_list_cont;
-  std::vector<PATH_TYPE> reversed_types = final_node.types;
-
-  // do reverse
-  reverse(reversed_x.begin(), reversed_x.end());
-  reverse(reversed_y.begin(), reversed_y.end());
-  reverse(reversed_yaw.begin(), reversed_yaw.end());
-  reverse(reversed_direct_cont.begin(), reversed_direct_cont.end());
-  reverse(reversed_types.begin(), reversed_types.end());
+Path HybridAStar::getFinalPath(const NodeHybrid& final_node, const NodePool<NodeHybrid>& node_pool)
+{
+  // collect segments from the final node back to the start
+  std::vector<TrajSegment> segments = { final_node.traj };
+  size_t nb_elements = final_node.traj.length;
 
   int64_t nid = final_node.parent_index;
-
-  // save start point of analytic expansion
-  int len_analytic = static_cast<int>(reversed_x.size());
-
   while (nid != -1)
   {
-    NodeHybrid node = closet_set.at(nid);
-    reverse(node.x_list.begin(), node.x_list.end());
-    reverse(node.y_list.begin(), node.y_list.end());
-    reverse(node.yaw_list.begin(), node.yaw_list.end());
-    reverse(node.dir_list_cont.begin(), node.dir_list_cont.end());
-    //    reverse(node.cont_cost_list.begin(), node.cont_cost_list.end());
-    reverse(node.types.begin(), node.types.end());
+    const NodeHybrid& node = node_pool.at(nid);
+    segments.push_back(node.traj);
+    nb_elements += node.traj.length;
     nid = node.parent_index;
-
-    util::extend_vector(reversed_x, node.x_list);
-    util::extend_vector(reversed_y, node.y_list);
-    util::extend_vector(reversed_yaw, node.yaw_list);
-    util::extend_vector(reversed_direct_cont, node.dir_list_cont);
-    //    util::extend_vector(reversed_cost, node.cont_cost_list);
-    util::extend_vector(reversed_types, node.types);
   }
 
-  reverse(reversed_x.begin(), reversed_x.end());
-  reverse(reversed_y.begin(), reversed_y.end());
-  reverse(reversed_yaw.begin(), reversed_yaw.end());
-  reverse(reversed_direct_cont.begin(), reversed_direct_cont.end());
-  //  reverse(reversed_cost.begin(), reversed_cost.end());
-  reverse(reversed_types.begin(), reversed_types.end());
+  // save start point of analytic expansion
+  const int len_analytic = static_cast<int>(final_node.traj.length);
+
+  // walk the segments from start to end, no reversing necessary
+  Path path;
+  path.x_list.reserve(nb_elements);
+  path.y_list.reserve(nb_elements);
+  path.yaw_list.reserve(nb_elements);
+  path.direction_list.reserve(nb_elements);
+  path.types.reserve(nb_elements);
+  for (auto segment = segments.rbegin(); segment != segments.rend(); ++segment)
+  {
+    traj_arena_.extendPath(*segment, path);
+  }
 
   // adjust first direction
-  if (reversed_direct_cont.size() > 1)
+  if (path.direction_list.size() > 1)
   {
-    reversed_direct_cont[0] = reversed_direct_cont[1];
+    path.direction_list[0] = path.direction_list[1];
   }
 
   // Get index of analytic part
-  int idx_start_analytic = -1;
   if (final_node.is_analytic)
   {
-    const int nb_elements = static_cast<int>(reversed_x.size());
-    idx_start_analytic = nb_elements - len_analytic + 1;
+    path.idx_analytic = static_cast<int>(nb_elements) - len_analytic + 1;
   }
+  path.cost = final_node.cost;
 
-  return { reversed_x,      reversed_y,         reversed_yaw,  reversed_direct_cont,
-           final_node.cost, idx_start_analytic, reversed_types };
+  return path;
 }
 
 /**
@@ -799,15 +877,14 @@ Path HybridAStar::getFinalPath(const NodeHybrid& final_node, const std::unordere
  * @param h_dp
  * @return
  */
-double HybridAStar::getDistance2goal(const NodeHybrid& node, const std::unordered_map<size_t, NodeDisc>& h_dp)
+double HybridAStar::getDistance2goal(const NodeHybrid& node, const NodeDiscGrid& h_dp)
 {
-  const size_t ind = AStar::calcIndex(node.x_index, node.y_index);
-  auto search = h_dp.find(ind);
-  if (search == h_dp.end())
+  const size_t ind = astar_.calcIndex(node.x_index, node.y_index);
+  if (!h_dp.contains(ind))
   {
     return OUT_OF_HEURISTIC;
   }
-  return search->second.cost_dist_;
+  return h_dp[ind].cost_dist_;
 }
 
 /**
@@ -817,13 +894,7 @@ double HybridAStar::getDistance2goal(const NodeHybrid& node, const std::unordere
  */
 double HybridAStar::getDistance2GlobalGoal(const NodeHybrid& node)
 {
-  const size_t ind = AStar::calcIndex(node.x_index, node.y_index);
-  const auto search = AStar::closed_set_guidance_.find(ind);
-  if (search == AStar::closed_set_guidance_.end())
-  {
-    return OUT_OF_HEURISTIC;
-  }
-  return search->second.cost_dist_;
+  return getDistance2goal(node, astar_.closed_set_guidance_);
 }
 
 /**
@@ -832,58 +903,104 @@ double HybridAStar::getDistance2GlobalGoal(const NodeHybrid& node)
  * @param h_dp
  * @return
  */
-bool HybridAStar::check4Expansions(const NodeHybrid& node, const std::unordered_map<size_t, NodeDisc>& h_dp)
+bool HybridAStar::check4Expansions(const NodeHybrid& node, const NodeDiscGrid& h_dp)
 {
-  const double dist2goal = getDistance2goal(node, h_dp);
-  const double dist = (dist_thresh_analytic_ - dist2goal) / dist_thresh_analytic_;
-  const double probability = 0 < dist ? dist : 0;
-  const double random_number = static_cast<double>(rand()) / static_cast<double>(RAND_MAX);
-  return (random_number < probability);
+  return expansion_scheduler_.shouldExpand(getDistance2goal(node, h_dp));
 }
 
-std::optional<ReedsSheppStateSpace::ReedsSheppPath> HybridAStar::getRSExpansionPath(const NodeHybrid& current,
-                                                                                    const NodeHybrid& goal)
+/**
+ * Samples a path from shortestPath while checking it for collisions. The end poses are checked first, then the poses in
+ * the middle between already checked ones with halving strides, so collisions are mostly found after few poses. Only
+ * the checked poses are interpolated
+ * @param state_space
+ * @param start
+ * @param goal
+ * @param path
+ * @return true if the path is collision free, it then contains all poses as from sample
+ */
+bool HybridAStar::sampleCollisionFreeRSPath(const ReedsSheppStateSpace& state_space,
+                                            const Pose<double>& start,
+                                            const Pose<double>& goal,
+                                            ReedsSheppStateSpace::ReedsSheppPath& path)
 {
-  const Pose<double> start_pose = { current.x_list.back(), current.y_list.back(), current.yaw_list.back() };
-  const Pose<double> goal_pose = { goal.x_list.back(), goal.y_list.back(), goal.yaw_list.back() };
-
-  const ReedsSheppStateSpace::ReedsSheppPath path1 =
-      getReedSheppPath(start_pose, goal_pose, motion_res_min_, 1 / Vehicle::max_curvature_);
-  const ReedsSheppStateSpace::ReedsSheppPath path2 =
-      getReedSheppPath(start_pose, goal_pose, motion_res_min_, 1 / (Vehicle::max_curvature_ * second_rs_steer_factor_));
-
-  const std::vector<ReedsSheppStateSpace::ReedsSheppPath> paths = { path1, path2 };
-
-  // No paths were found
-  if (paths.empty())
+  const size_t nb_samples = state_space.nbSamples(path, params_.motion_res_min);
+  path.x_list.resize(nb_samples + 1);
+  path.y_list.resize(nb_samples + 1);
+  path.yaw_list.resize(nb_samples + 1);
+  path.directions.resize(nb_samples + 1);
+
+  const auto check_sample = [&](size_t idx) {
+    int direction;
+    const Pose<double> pose =
+        state_space.interpolate(start, path, static_cast<double>(idx) * params_.motion_res_min, direction);
+    path.x_list[idx] = pose.x;
+    path.y_list[idx] = pose.y;
+    path.yaw_list[idx] = pose.yaw;
+    path.directions[idx] = direction;
+    return collision_checker_.checkPose(pose);
+  };
+
+  if (!collision_checker_.checkPose(goal) || !check_sample(0))
   {
-    return {};
+    return false;
   }
-
-  // Get best path
-  ReedsSheppStateSpace::ReedsSheppPath best_path;
-  double best_cost = -1;
-  for (const auto& path : paths)
+  // Every other index is an odd multiple of exactly one stride
+  for (size_t stride = std::bit_floor(std::max<size_t>(nb_samples - 1, 1)); stride > 0; stride /= 2)
   {
-    if (CollisionChecker::checkPathCollision(path.x_list, path.y_list, path.yaw_list))
+    for (size_t idx = stride; idx < nb_samples; idx += 2 * stride)
     {
-      // calculate costs
-      const double cost = getRSPathCosts(path);
-
-      // Set as best path if costs are lower
-      if (best_cost == -1 || cost < best_cost)
+      if (!check_sample(idx))
       {
-        best_cost = cost;
-        best_path = path;
-        best_path.cost = best_cost;
+        return false;
       }
     }
   }
 
-  // If collision free path was found
-  if (best_cost > -1)
+  // Add goal pose again
+  path.x_list[nb_samples] = goal.x;
+  path.y_list[nb_samples] = goal.y;
+  path.yaw_list[nb_samples] = goal.yaw;
+  path.directions[nb_samples] = path.directions[nb_samples - 1];
+  return true;
+}
+
+/**
+ * Shortest collision free Reeds-Shepp path to the goal with the minimal and a larger turning radius. The candidates are
+ * ranked by their costs from the segment lengths and checked in this order, so mostly only the cheaper one is sampled
+ * @param current
+ * @param goal
+ * @return
+ */
+std::optional<ReedsSheppStateSpace::ReedsSheppPath> HybridAStar::getRSExpansionPath(const NodeHybrid& current,
+                                                                                    const NodeHybrid& goal)
+{
+  const Pose<double>& start_pose = current.pose;
+  const Pose<double>& goal_pose = goal.pose;
+
+  const std::array<ReedsSheppStateSpace, 2> state_spaces = {
+    ReedsSheppStateSpace(1 / vehicle_.max_curvature_),
+    ReedsSheppStateSpace(1 / (vehicle_.max_curvature_ * params_.second_rs_steer_factor))
+  };
+
+  std::array<ReedsSheppStateSpace::ReedsSheppPath, 2> paths;
+  for (size_t idx = 0; idx < paths.size(); ++idx)
+  {
+    paths[idx] = state_spaces[idx].shortestPath(start_pose, goal_pose);
+    paths[idx].cost = getRSPathCosts(paths[idx]);
+  }
+  std::array<size_t, 2> order = { 0, 1 };
+  if (paths[1].cost < paths[0].cost)
+  {
+    std::swap(order[0], order[1]);
+  }
+
+  // Check the candidates by increasing costs, the first collision free one is the best
+  for (const size_t idx : order)
   {
-    return best_path;
+    if (sampleCollisionFreeRSPath(state_spaces[idx], start_pose, goal_pose, paths[idx]))
+    {
+      return std::move(paths[idx]);
+    }
   }
 
   return {};
@@ -900,19 +1017,24 @@ NodeHybrid HybridAStar::getFinalNodeFromPath(const NodeHybrid& current,
   const size_t f_parent_index = calculateIndex(current.x_index, current.y_index, current.yaw_index);
   const double f_steer = 0.0;
 
-  // Set type of path segment
+  // Store path without its first pose, which is the last pose of the current node
   size_t vec_size = analytic_path.x_list.size() - 1;
-  const std::vector<PATH_TYPE> types(vec_size, path_type);
+  const TrajSegment traj = traj_arena_.append(analytic_path.x_list,
+                                              analytic_path.y_list,
+                                              analytic_path.yaw_list,
+                                              analytic_path.directions,
+                                              path_type,
+                                              1);
+  const Pose<double> last_pose = { analytic_path.x_list.back(),
+                                   analytic_path.y_list.back(),
+                                   analytic_path.yaw_list.back() };
 
   return { current.x_index,
            current.y_index,
            current.yaw_index,
            current.discrete_direction,
-           std::vector<int>(analytic_path.directions.begin() + 1, analytic_path.directions.end()),
-           std::vector<double>(analytic_path.x_list.begin() + 1, analytic_path.x_list.end()),
-           std::vector<double>(analytic_path.y_list.begin() + 1, analytic_path.y_list.end()),
-           std::vector<double>(analytic_path.yaw_list.begin() + 1, analytic_path.yaw_list.end()),
-           types,
+           traj,
+           last_pose,
            f_steer,
            static_cast<int64_t>(f_parent_index),
            f_cost,
@@ -929,7 +1051,7 @@ std::optional<NodeHybrid> HybridAStar::getRSExpansion(const NodeHybrid& current,
 {
   if (const auto analytic_path = getRSExpansionPath(current, goal))
   {
-    return getFinalNodeFromPath(current, *analytic_path, PATH_TYPE::REEDS_SHEPP, motion_res_min_);
+    return getFinalNodeFromPath(current, *analytic_path, PATH_TYPE::REEDS_SHEPP, params_.motion_res_min);
   }
   return {};
 }
@@ -940,93 +1062,74 @@ double HybridAStar::getDrivenAngleDiff(double angle1, double angle2, char direct
   return util::getAngleDiff(angle1, angle2) * sign;
 }
 
-void HybridAStar::recalculateLength(ReedsSheppStateSpace::ReedsSheppPath& path)
-{
-  /**
-   * This is a bugfix function to recalculate the length of the RS curves which is probably false in omp
-   */
-  // Recalculate length because the stored one is false!
-  double len_calc = 0;
-  for (unsigned int i = 0; i < path.yaw_list.size() - 1; ++i)
-  {
-    const double diff_x = path.x_list[i + 1] - path.x_list[i];
-    const double diff_y = path.y_list[i + 1] - path.y_list[i];
-    len_calc += sqrt(pow(diff_x, 2) + pow(diff_y, 2));
-  }
-  // Correct also vector of partly lengths
-  const double length_correction_factor = len_calc / path.totalLength_;
-  for (auto& len : path.lengths)
-  {
-    len *= length_correction_factor;
-  }
-
-  path.totalLength_ = len_calc;
-}
-
 void HybridAStar::calculateNonhnoobs()
 {
-  // Prepare non holon no obs heuristic
-  non_h_no_obs_.resize_and_reset(astar_yaw_dim_, non_h_no_obs_patch_dim_, non_h_no_obs_patch_dim_, 0);
-  non_h_no_obs_.setName("non_h_no_obs");
   non_h_no_obs_calculated_ = true;
 
-  std::string filename = "/nonh_noobs.data";
-  //  LOG_DEB("Trying to find data in " << path2data_ + filename);
-  if (std::filesystem::exists(path2data_ + filename))
+  // Every parameter the table depends on is part of the key
+  const double max_radius = 1 / vehicle_.max_curvature_;
+  const auto value_type = static_cast<NonhTable::ValueType>(params_.nonh_table_type);
+  // The symmetric layout needs the goal in the center cell
+  const auto layout = (params_.nonh_table_symmetric && params_.non_h_no_obs_patch_dim % 2 == 1) ? NonhTable::SYMMETRIC :
+                                                                                      NonhTable::FULL;
+  const uint64_t key = NonhTable::hashKey({ static_cast<double>(NonhTable::VERSION),
+                                            static_cast<double>(value_type),
+                                            static_cast<double>(layout),
+                                            params_.astar_res,
+                                            static_cast<double>(params_.astar_yaw_res_deg),
+                                            static_cast<double>(params_.astar_yaw_dim),
+                                            static_cast<double>(params_.non_h_no_obs_patch_dim),
+                                            max_radius });
+  std::stringstream filename;
+  filename << "/nonh_noobs_" << std::hex << key << ".table";
+  const std::string path = path2data_ + filename.str();
+
+  const int patch_dim = static_cast<int>(params_.non_h_no_obs_patch_dim);
+  if (non_h_no_obs_.load(path, key, static_cast<int>(params_.astar_yaw_dim), patch_dim, value_type, layout))
   {
-    //    LOG_DEB("Reading existing non-holonomic no obstacle heuristic");
-    std::ifstream input_file(path2data_ + filename);
-
-    input_file.seekg(0);
-    input_file.read(reinterpret_cast<char*>(non_h_no_obs_.data_ref().data()),
-                    non_h_no_obs_.data_ref().size() * sizeof(double));
-    input_file.close();
-
     return;
   }
 
   //  LOG_DEB("Calculating non-holonomic no obstacle heuristic");
-  const int goal_x = std::floor(non_h_no_obs_patch_dim_ / 2);
+  const int goal_x = std::floor(params_.non_h_no_obs_patch_dim / 2);
   const int goal_y = goal_x;
   const double goal_yaw = 0.0;
-
-  double max_radius = 1 / Vehicle::max_curvature_;
-
-  for (int angle_idx = 0, angle = -180; angle < 180; angle += astar_yaw_res_deg_, ++angle_idx)
-  {
-    for (int x_ind = 0; x_ind < non_h_no_obs_patch_dim_; ++x_ind)
+  const Pose<double> goal = { static_cast<double>(goal_x) * params_.astar_res,
+                              static_cast<double>(goal_y) * params_.astar_res,
+                              goal_yaw };
+
+  // Distances of whole rows at once, without sampling the paths
+  const ReedsSheppStateSpace state_space(max_radius);
+  const auto calc_row = [&](int angle_idx, int y_ind, int x_ind, std::span<float> values) {
+    const double angle_rad = util::TO_RAD * (-180 + angle_idx * params_.astar_yaw_res_deg);
+
+    // set start and goal coordinates in meters to ensure the length is in meters
+    std::vector<Pose<double>> starts(values.size());
+    for (size_t idx = 0; idx < values.size(); ++idx)
     {
-      for (int y_ind = 0; y_ind < non_h_no_obs_patch_dim_; ++y_ind)
-      {
-        double angle_rad = util::TO_RAD * angle;
+      starts[idx] = { static_cast<double>(x_ind + static_cast<int>(idx)) * params_.astar_res,
+                      static_cast<double>(y_ind) * params_.astar_res,
+                      angle_rad };
+    }
+    std::vector<double> dists(values.size());
+    state_space.distances(starts, goal, dists);
 
-        // if goal is equal start set length to zero and continue
-        if ((x_ind == goal_x) && (y_ind == goal_y) && (angle_rad == goal_yaw))
-        {
-          non_h_no_obs_(angle_idx, y_ind, x_ind) = 0.0;
-          continue;
-        }
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+      values[idx] = static_cast<float>(dists[idx]);
+    }
 
-        // set start and goal coordinates in meters to ensure the length is in meters
-        const Pose<double> start = { static_cast<double>(x_ind) * astar_res_,
-                                     static_cast<double>(y_ind) * astar_res_,
-                                     angle_rad };
-        const Pose<double> goal = { static_cast<double>(goal_x) * astar_res_,
-                                    static_cast<double>(goal_y) * astar_res_,
-                                    goal_yaw };
-
-        // do Reeds Shepp planning
-        ReedsSheppStateSpace::ReedsSheppPath path = getReedSheppPath(start, goal, motion_res_min_, max_radius);
-        non_h_no_obs_(angle_idx, y_ind, x_ind) = path.totalLength_;
-      }
+    // if goal is equal start set length to zero
+    if (y_ind == goal_y && angle_rad == goal_yaw && x_ind <= goal_x && goal_x < x_ind + static_cast<int>(values.size()))
+    {
+      values[goal_x - x_ind] = 0.0F;
     }
-  }
+  };
 
-  // write vector to file
-  std::ofstream output_file(path2data_ + filename);
-  output_file.write(reinterpret_cast<char*>(non_h_no_obs_.data_ref().data()),
-                    non_h_no_obs_.data_ref().size() * sizeof(double));
-  output_file.close();
+  const size_t nb_threads =
+      params_.nonh_table_threads > 0 ? params_.nonh_table_threads : std::thread::hardware_concurrency();
+  non_h_no_obs_.generate(
+      path, key, static_cast<int>(params_.astar_yaw_dim), patch_dim, value_type, layout, nb_threads, calc_row);
 }
 
 std::vector<double> HybridAStar::angleArange(double angle1, double angle2, char direction, double angle_res)
@@ -1119,10 +1222,10 @@ std::optional<NodeHybrid> HybridAStar::getRearAxisPath(const NodeHybrid& current
   /**
    * Try to intersect two lines. If they do, this is the turning point
    */
-  const Pose<double> start = { current_node.x_list.back(), current_node.y_list.back(), current_node.yaw_list.back() };
-  const Pose<double> goal = { goal_node.x_list.back(), goal_node.y_list.back(), goal_node.yaw_list.back() };
+  const Pose<double>& start = current_node.pose;
+  const Pose<double>& goal = goal_node.pose;
 
-  const double turn_s = turn_on_point_horizon_;
+  const double turn_s = params_.turn_on_point_horizon;
 
   // line 1
   Point<double> pointA = { start.x - turn_s * cos(start.yaw), start.y - turn_s * sin(start.yaw) };
@@ -1141,17 +1244,18 @@ std::optional<NodeHybrid> HybridAStar::getRearAxisPath(const NodeHybrid& current
     // Get coordinate where lines intersect
     double s_1 = s2intersect.x;
     double s_2 = s2intersect.y;
-    double ds1 = (s_1 >= 0) ? interp_res_ : -interp_res_;
+    double ds1 = (s_1 >= 0) ? params_.interp_res : -params_.interp_res;
     size_t nb_el_1 = ceil(s_1 / ds1);
     ds1 = s_1 / static_cast<double>(nb_el_1 - 1);
-    double ds2 = (s_2 >= 0) ? interp_res_ : -interp_res_;
+    double ds2 = (s_2 >= 0) ? params_.interp_res : -params_.interp_res;
     size_t nb_el_2 = ceil(s_2 / ds2);
     ds2 = s_2 / static_cast<double>(nb_el_2 - 1);
 
     // Get angles of turning point
     double diff = util::getSignedAngleDiff(goal.yaw, start.yaw);
     char turn_direction = (diff > 0) ? 'L' : 'R';
-    const std::vector<double> yaw_fill = angleArange(start.yaw, goal.yaw, turn_direction, yaw_res_coll_ * util::TO_RAD);
+    const std::vector<double> yaw_fill =
+        angleArange(start.yaw, goal.yaw, turn_direction, params_.yaw_res_coll * util::TO_RAD);
     size_t nb_fill = yaw_fill.size();
     size_t total_size = nb_el_1 + nb_fill + nb_el_2;
     std::vector<double> x_list(total_size, 0);
@@ -1199,7 +1303,7 @@ std::optional<NodeHybrid> HybridAStar::getRearAxisPath(const NodeHybrid& current
       s_val += ds2;
     }
 
-    if (CollisionChecker::checkPathCollision(x_list, y_list, yaw_list))
+    if (collision_checker_.checkPathCollision(x_list, y_list, yaw_list))
     {
       ReedsSheppStateSpace::ReedsSheppPath path;
       path.x_list = std::move(x_list);
@@ -1211,7 +1315,7 @@ std::optional<NodeHybrid> HybridAStar::getRearAxisPath(const NodeHybrid& current
       path.totalLength_ = s_1 + s_2;
       path.cost = getRAPathCosts(path);
 
-      return getFinalNodeFromPath(current_node, path, PATH_TYPE::REAR_AXIS, interp_res_);
+      return getFinalNodeFromPath(current_node, path, PATH_TYPE::REAR_AXIS, params_.interp_res);
     }
     return {};
   }
@@ -1227,9 +1331,9 @@ std::optional<NodeHybrid> HybridAStar::getRearAxisPath(const NodeHybrid& current
  */
 NodeHybrid HybridAStar::createNode(const Pose<double>& pose, double steer)
 {
-  return { static_cast<int>(round(pose.x * grid_tf::con2star_)),
-           static_cast<int>(round(pose.y * grid_tf::con2star_)),
-           static_cast<int>(round(pose.yaw / astar_yaw_res_)),
+  return { static_cast<int>(round(pose.x * grid_tf_.con2star_)),
+           static_cast<int>(round(pose.y * grid_tf_.con2star_)),
+           static_cast<int>(round(pose.yaw / params_.astar_yaw_res)),
            1,
            { 1 },
            { pose.x },
@@ -1251,28 +1355,27 @@ void HybridAStar::recalculateEnv(const NodeHybrid& goal_node, const NodeHybrid&
 {
   //  auto start = std::chrono::high_resolution_clock::now();
 
-  //  AStar::calcAstarGrid();
-  AStar::calcAstarGridCuda();
+  astar_.calcAstarGrid();
 
   //  auto after_grid = std::chrono::high_resolution_clock::now();
 
   const Point<int> ego_index = { ego_node.x_index, ego_node.y_index };
 
-  AStar::calcVoronoiPotentialField(ego_index);
+  astar_.calcVoronoiPotentialField(ego_index);
 
   //  auto after_voronoi = std::chrono::high_resolution_clock::now()
 
   // try out opencv voronoi distance
   //  cv::Mat dist;
   //  const int mask_size = 3;
-  ////  cv::distanceTransform(AStar::astar_grid_.data(), AStar::h_prox_arr_.data(), cv::DIST_L2, mask_size,
+  ////  cv::distanceTransform(astar_.astar_grid_.data(), astar_.h_prox_arr_.data(), cv::DIST_L2, mask_size,
   /// cv::DIST_LABEL_PIXEL);  // cv::DIST_LABEL_CCOMP
-  //  cv::distanceTransform(AStar::astar_grid_.data(), dist, cv::DIST_L2, mask_size, cv::DIST_LABEL_PIXEL);  //
+  //  cv::distanceTransform(astar_.astar_grid_.data(), dist, cv::DIST_L2, mask_size, cv::DIST_LABEL_PIXEL);  //
   //  cv::DIST_LABEL_CCOMP
-  ////  AStar::h_prox_arr_.vec = dist.data;
+  ////  astar_.h_prox_arr_.vec = dist.data;
   //  cv::imshow("test", dist);
 
-  AStar::calcDistanceHeuristic({ goal_node.x_index, goal_node.y_index }, { ego_node.x_index, ego_node.y_index }, false);
+  astar_.calcDistanceHeuristic({ goal_node.x_index, goal_node.y_index }, { ego_node.x_index, ego_node.y_index }, false);
 
   //  auto end = std::chrono::high_resolution_clock::now();
 
@@ -1294,9 +1397,9 @@ void HybridAStar::updateLaneGraph(const Point<double>& origin_utm, double patch_
 {
   lane_graph_.init(origin_utm, patch_dim);
 
-  AStar::resetMovementMap();
+  astar_.resetMovementMap();
 
-  AStar::setMovementMap(lane_graph_.edges_);
+  astar_.setMovementMap(lane_graph_.edges_);
 }
 
 void HybridAStar::smoothPositions(std::vector<Point<double>>& positions)
@@ -1436,7 +1539,7 @@ void HybridAStar::interpolateLaneNodes(std::vector<LaneNode>& nodes)
   auto spline_y = fitpack_wrapper::BSpline1D(s_list, y_list, degree, smoothing);
 
   // insert interpolated elements
-  int nb_els = static_cast<int>(s_list.back() / motion_res_max_);
+  int nb_els = static_cast<int>(s_list.back() / params_.motion_res_max);
   nodes.clear();
   nodes.reserve(nb_els);
 
@@ -1444,7 +1547,144 @@ void HybridAStar::interpolateLaneNodes(std::vector<LaneNode>& nodes)
   while (s_dist < s_list.back())
   {
     nodes.emplace_back(Point<double>(spline_x(s_dist), spline_y(s_dist)));
-    s_dist += motion_res_max_;
+    s_dist += params_.motion_res_max;
+  }
+}
+
+/**
+ * Resets the state of the last search, the memory of the pools is kept
+ */
+void HybridAStar::resetSearch()
+{
+  primitive_cache_.updateFootprints();
+  node_pool_.resize(getNbStates());
+  node_pool_.reset();
+  open_queue_.resize(getNbStates());
+  expansion_scheduler_.reset();
+  traj_arena_.reset();
+  connected_closed_nodes_.first.clear();   // reset for correct vis
+  connected_closed_nodes_.second.clear();  // reset for correct vis
+  is_partial_ = false;
+  inflation_ = 1;
+}
+
+/**
+ * Adds the start node to the frontier to explore from
+ * @param start_node
+ * @param goal_node
+ * @param dist_heuristic
+ * @return false if the start node is not on the grid
+ */
+bool HybridAStar::putStartNode(const NodeHybrid& start_node,
+                               const NodeHybrid& goal_node,
+                               const NodeDiscGrid& dist_heuristic)
+{
+  // Start node must be on the grid to be addressable in the node pool
+  if (!verifyIndex(start_node.x_index, start_node.y_index))
+  {
+    return false;
+  }
+
+  size_t start_index = calculateIndex(start_node.x_index, start_node.y_index, start_node.yaw_index);
+  open_queue_.put(start_index, calcCost(start_node, goal_node, dist_heuristic));
+  NodeHybrid start = start_node;
+  start.traj = traj_arena_.append(start_node);
+  node_pool_.insert(start_index, std::move(start));
+  return true;
+}
+
+/**
+ * Tries to reach the goal from the node with a Reeds-Shepp curve and by turning on the rear axis
+ * @param current_node
+ * @param goal_node
+ * @param final_nodes the found final nodes are appended
+ */
+void HybridAStar::tryAnalyticExpansions(const NodeHybrid& current_node,
+                                        const NodeHybrid& goal_node,
+                                        std::vector<NodeHybrid>& final_nodes)
+{
+  const auto t_attempt = std::chrono::high_resolution_clock::now();
+  bool rs_found = false;
+  bool ra_found = false;
+
+  // A valid final path was found by RS curves
+  if (const auto final_rs_node = getRSExpansion(current_node, goal_node))
+  {
+    final_nodes.push_back(std::move(*final_rs_node));
+    rs_found = true;
+  }
+
+  // Try finding final node by turning on rear axis
+  if (params_.can_turn_on_point)
+  {
+    // Final path was found
+    if (const auto final_ra_node = getRearAxisPath(current_node, goal_node))
+    {
+      final_nodes.push_back(std::move(*final_ra_node));
+      ra_found = true;
+    }
+  }
+  const std::chrono::duration<double, std::milli> attempt_ms = std::chrono::high_resolution_clock::now() - t_attempt;
+  expansion_scheduler_.recordAttempt(rs_found, ra_found, attempt_ms.count());
+}
+
+/**
+ * Adds the neighbors of the node to the open list or updates the open ones that are reached cheaper
+ * @param current_node
+ * @param goal_node
+ * @param dist_heuristic
+ */
+void HybridAStar::expandNeighbors(const NodeHybrid& current_node,
+                                  const NodeHybrid& goal_node,
+                                  const NodeDiscGrid& dist_heuristic)
+{
+  // Change the motion resolution depending on the free space
+  const double motion_res = astar_.motion_res_map_(current_node.y_index, current_node.x_index);
+
+  // Get neighbour nodes that can be reached from current one by applying steering
+  setNeighbors(current_node, neighbors_, motion_res);
+  for (auto& neighbor : neighbors_)
+  {
+    // Get unique index
+    const size_t next_idx = calculateIndex(neighbor.x_index, neighbor.y_index, neighbor.yaw_index);
+
+    // Node was already visited
+    const auto status = node_pool_.getStatus(next_idx);
+    if (status == NodePool<NodeHybrid>::CLOSED)
+    {
+      // The update of a closed node cannot be implemented because it would cause steps in the path
+      continue;
+    }
+
+    // Node is already in open list
+    if (status == NodePool<NodeHybrid>::OPEN)
+    {
+      if (node_pool_.at(next_idx).cost > neighbor.cost)
+      {
+        // Add to cost
+        const double node_cost = calcCost(neighbor, goal_node, dist_heuristic);
+
+        open_queue_.put(next_idx, node_cost);
+        neighbor.traj = traj_arena_.append(neighbor_traj_, neighbor.traj);
+        node_pool_.replace(next_idx, neighbor);
+      }
+    }
+    // Node is not in open list and hence unknown, add it to open list!
+    else
+    {
+      // Add to cost
+      const double node_cost = calcCost(neighbor, goal_node, dist_heuristic);
+
+      // Check if node is out of heuristic, if yes don't add it to open list
+      if (node_cost == OUT_OF_HEURISTIC)
+      {
+        continue;
+      }
+
+      open_queue_.put(next_idx, node_cost);
+      neighbor.traj = traj_arena_.append(neighbor_traj_, neighbor.traj);
+      node_pool_.insert(next_idx, neighbor);
+    }
   }
 }
 
@@ -1452,33 +1692,34 @@ std::optional<NodeHybrid> HybridAStar::hAstarCore(const NodeHybrid& ego_node,
                                                   const NodeHybrid& start_node,
                                                   const NodeHybrid& goal_node,
                                                   bool to_final_pose,
-                                                  bool do_analytic)
+                                                  bool do_analytic,
+                                                  const SearchOptions& options)
 {
-  open_set_.clear();
-  closed_set_.clear();
-  connected_closed_nodes_.first.clear();   // reset for correct vis
-  connected_closed_nodes_.second.clear();  // reset for correct vis
+  resetSearch();
 
-  std::unordered_map<size_t, NodeDisc>* dist_heuristic;
+  // A given goal heuristic replaces the guidance and the path heuristic of the environment
+  const NodeDiscGrid* guidance =
+      options.goal_heuristic != nullptr ? options.goal_heuristic : &astar_.closed_set_guidance_;
+  const NodeDiscGrid* dist_heuristic;
 
   // choose between waypoint types
-  double start_heur_cost = getDistance2GlobalGoal(ego_node);
-  if (waypoint_type_ == HEUR_RED or waypoint_type_ == NONE)
+  double start_heur_cost = getDistance2goal(ego_node, *guidance);
+  if (params_.waypoint_type == HEUR_RED or params_.waypoint_type == NONE or options.goal_heuristic != nullptr)
   {
-    dist_heuristic = &AStar::closed_set_guidance_;
+    dist_heuristic = guidance;
   }
   else
   {
     bool for_path = true;
-    AStar::calcDistanceHeuristic(
+    astar_.calcDistanceHeuristic(
         { goal_node.x_index, goal_node.y_index }, { start_node.x_index, start_node.y_index }, for_path);
-    dist_heuristic = &AStar::closed_set_path_;
+    dist_heuristic = &astar_.closed_set_path_;
   }
 
-  // Add start node to frontier to explore from
-  size_t start_index = calculateIndex(start_node.x_index, start_node.y_index, start_node.yaw_index);
-  open_queue_.put(start_index, calcCost(start_node, goal_node, *dist_heuristic));
-  open_set_.insert({ start_index, start_node });
+  if (!putStartNode(start_node, goal_node, *dist_heuristic))
+  {
+    return {};
+  }
 
   size_t curr_open_idx;
   size_t last_closed_node_index = 0;
@@ -1486,8 +1727,24 @@ std::optional<NodeHybrid> HybridAStar::hAstarCore(const NodeHybrid& ego_node,
   //  size_t nb_nodes = 0;
   size_t nb_nodes_since_final = 0;
 
+  // Closed node closest to the goal, returned if the search is stopped early. The searches to several goals are
+  // compared by their costs, so they never return a partial path
+  const bool track_partial = params_.partial_path and options.goal_heuristic == nullptr;
+  std::optional<size_t> partial_index;
+  double partial_heur_cost = OUT_OF_HEURISTIC;
+  const auto stop = [&]() -> std::optional<NodeHybrid> {
+    if (!partial_index)
+    {
+      return {};
+    }
+    is_partial_ = true;
+    return node_pool_.at(*partial_index);
+  };
+
+  // The clock and the cancel token are only checked every few iterations
+  size_t nb_iter_since_check = 0;
   auto t_1 = std::chrono::high_resolution_clock::now();
-  std::chrono::duration<double, std::milli> timeout = std::chrono::milliseconds(timeout_ms_);
+  std::chrono::duration<double, std::milli> timeout = std::chrono::milliseconds(params_.timeout_ms);
   while (true)
   {
     // open set is empty
@@ -1495,14 +1752,37 @@ std::optional<NodeHybrid> HybridAStar::hAstarCore(const NodeHybrid& ego_node,
     {
       //      LOG_ERR("Cannot find path, No open set");
 
-      return closed_set_.at(last_closed_node_index);
+      // The searches to several goals are compared by their costs, so they only return paths that reach the goal
+      if (options.goal_heuristic != nullptr)
+      {
+        return {};
+      }
+      return node_pool_.at(last_closed_node_index);
     }
-    // Execution took too long
-    auto t_2 = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double, std::milli> ms_double = t_2 - t_1;
-    if (ms_double > timeout)
+    if (++nb_iter_since_check >= params_.deadline_check_interval)
+    {
+      nb_iter_since_check = 0;
+
+      // Execution took too long
+      auto t_2 = std::chrono::high_resolution_clock::now();
+      std::chrono::duration<double, std::milli> ms_double = t_2 - t_1;
+      if (ms_double > timeout)
+      {
+        //      LOG_ERR("Execution took too long, no path was found");
+        return stop();
+      }
+
+      // Cancelled from another thread
+      if (options.cancel_token != nullptr && options.cancel_token->isCancelled())
+      {
+        return stop();
+      }
+    }
+
+    // No path cheaper than the bound can be found anymore if the heuristic does not overestimate
+    if (options.cost_bound != nullptr &&
+        open_queue_.topPriority() >= options.cost_bound->load(std::memory_order_relaxed))
     {
-      //      LOG_ERR("Execution took too long, no path was found");
       return {};
     }
 
@@ -1510,23 +1790,31 @@ std::optional<NodeHybrid> HybridAStar::hAstarCore(const NodeHybrid& ego_node,
     curr_open_idx = open_queue_.get();
 
     // Node is in open list --> move to explored ones
-    const auto search_current = open_set_.find(curr_open_idx);
-    if (search_current != open_set_.end())
+    if (node_pool_.isOpen(curr_open_idx))
     {
-      const NodeHybrid current_node = search_current->second;
+      // copied, the reference into the pool is invalidated by inserting the neighbors
+      const NodeHybrid current_node = node_pool_.close(curr_open_idx);
       last_closed_node_index = curr_open_idx;
-      closed_set_.insert({ curr_open_idx, current_node });
-      open_set_.erase(curr_open_idx);
+
+      if (track_partial)
+      {
+        const double heur_cost = getDistance2goal(current_node, *guidance);
+        if (heur_cost < partial_heur_cost)
+        {
+          partial_heur_cost = heur_cost;
+          partial_index = curr_open_idx;
+        }
+      }
 
       if (do_analytic)
       {
         /// Heuristic reduction
-        if (waypoint_type_ == HEUR_RED and not to_final_pose)
+        if (params_.waypoint_type == HEUR_RED and not to_final_pose)
         {
           // Early stopping based on heuristic decrease
-          const double current_heur_cost = getDistance2GlobalGoal(current_node);
+          const double current_heur_cost = getDistance2goal(current_node, *guidance);
           const double heur_diff = start_heur_cost - current_heur_cost;
-          if (heur_diff > waypoint_dist_)
+          if (heur_diff > params_.waypoint_dist)
           {
             return current_node;
           }
@@ -1535,27 +1823,13 @@ std::optional<NodeHybrid> HybridAStar::hAstarCore(const NodeHybrid& ego_node,
         /// Try to reach final goal with extensions
         if (check4Expansions(current_node, *dist_heuristic))
         {
-          // A valid final path was found by RS curves
-          if (const auto final_rs_node = getRSExpansion(current_node, goal_node))
-          {
-            final_nodes.push_back(std::move(*final_rs_node));
-          }
-
-          // Try finding final node by turning on rear axis
-          if (can_turn_on_point_)
-          {
-            // Final path was found
-            if (const auto final_ra_node = getRearAxisPath(current_node, goal_node))
-            {
-              final_nodes.push_back(std::move(*final_ra_node));
-            }
-          }
+          tryAnalyticExpansions(current_node, goal_node, final_nodes);
 
           // Breakout after x additional nodes were found
           if (!final_nodes.empty())
           {
             nb_nodes_since_final++;
-            if (nb_nodes_since_final > max_extra_nodes_)
+            if (nb_nodes_since_final > params_.max_extra_nodes)
             {
               // Take final nodes with the lowest cost
               std::sort(final_nodes.begin(), final_nodes.end());
@@ -1571,67 +1845,20 @@ std::optional<NodeHybrid> HybridAStar::hAstarCore(const NodeHybrid& ego_node,
       else
       {
         /// Waypoint path
-        double node_angle = util::constrainAngleZero2Pi(current_node.yaw_list.back());
-        double goal_angle = util::constrainAngleZero2Pi(goal_node.yaw_list.front());
+        double node_angle = util::constrainAngleZero2Pi(current_node.pose.yaw);
+        double goal_angle = util::constrainAngleZero2Pi(goal_node.pose.yaw);
 
         // If no analytic solution is necessary, waypoints must be reached only approximately
-        const double dist2 = pow((current_node.x_list.back() - goal_node.x_list.front()), 2) +
-                             pow((current_node.y_list.back() - goal_node.y_list.front()), 2);
-        if (dist2 < approx_goal_dist2_ && anglesApproxEqual02Pi(goal_angle, node_angle))
+        const double dist2 =
+            pow((current_node.pose.x - goal_node.pose.x), 2) + pow((current_node.pose.y - goal_node.pose.y), 2);
+        if (dist2 < params_.approx_goal_dist2 && anglesApproxEqual02Pi(goal_angle, node_angle))
         {
           return current_node;
         }
       }
 
-      // Change the motion resolution depending on the free space
-      const double motion_res = AStar::motion_res_map_(current_node.y_index, current_node.x_index);
-
-      // Get neighbour nodes that can be reached from current one by applying steering
-      setNeighbors(current_node, neighbors_, motion_res);
-      for (const auto& neighbor : neighbors_)
-      {
-        // Get unique index
-        const size_t next_idx = calculateIndex(neighbor.x_index, neighbor.y_index, neighbor.yaw_index);
-
-        // Node was already visited
-        if (closed_set_.contains(next_idx))
-        {
-          // The update of a closed node cannot be implemented because it would cause steps in the path
-          continue;
-        }
-
-        // Node is already in open list
-        const auto search_next = open_set_.find(next_idx);
-        if (search_next != open_set_.end())
-        {
-          const NodeHybrid found_node = search_next->second;
-          if (found_node.cost > neighbor.cost)
-          {
-            // Add to cost
-            const double node_cost = calcCost(neighbor, goal_node, *dist_heuristic);
-
-            open_queue_.put(next_idx, node_cost);
-            open_set_.erase(next_idx);
-            open_set_.emplace(next_idx, neighbor);
-          }
-        }
-        // Node is not in open list and hence unknown, add it to open list!
-        else
-        {
-          // Add to cost
-          const double node_cost = calcCost(neighbor, goal_node, *dist_heuristic);
-
-          // Check if node is out of heuristic, if yes don't add it to open list
-          if (node_cost == OUT_OF_HEURISTIC)
-          {
-            continue;
-          }
-
-          open_queue_.put(next_idx, node_cost);
-          open_set_.insert({ next_idx, neighbor });
-        }
-      }
-      // Node from heap is not in open list, This happens by updating the nodes in the open list!
+      expandNeighbors(current_node, goal_node, *dist_heuristic);
+      // Node from heap is not in open list, can not happen as queued nodes are updated instead of pushed again
     }
     else
     {
@@ -1646,28 +1873,192 @@ std::optional<Path> HybridAStar::hybridAStarPlanning(const NodeHybrid& ego_node,
                                                      const NodeHybrid& goal_node,
                                                      bool to_final_pose,
                                                      bool do_analytic)
+{
+  return planPath(ego_node, start_node, goal_node, to_final_pose, do_analytic, {});
+}
+
+/**
+ * Plans like hybridAStarPlanning with optional inputs besides the environment. A given goal heuristic, e.g. from
+ * AStar::calcGoalHeuristic, replaces the one of the environment. The search gives up as soon as the lowest costs of its
+ * open list reach the cost bound, which is exact as long as the heuristic does not overestimate (H_DIST_COST <= 1), or
+ * when the cancel token is set. With PARTIAL_PATH a search stopped by the timeout or the token returns the path to its
+ * closed node closest to the goal, marked as partial
+ * @param ego_node
+ * @param start_node
+ * @param goal_node
+ * @param to_final_pose
+ * @param do_analytic
+ * @param options
+ * @return
+ */
+std::optional<Path> HybridAStar::planPath(const NodeHybrid& ego_node,
+                                          const NodeHybrid& start_node,
+                                          const NodeHybrid& goal_node,
+                                          bool to_final_pose,
+                                          bool do_analytic,
+                                          const SearchOptions& options)
 {
   //  auto start_time = std::chrono::high_resolution_clock::now();
 
-  if (const auto final_node = hAstarCore(ego_node, start_node, goal_node, to_final_pose, do_analytic))
+  if (const auto final_node =
+          hAstarCore(ego_node, start_node, goal_node, to_final_pose, do_analytic, options))
   {
-    Path path = getFinalPath(*final_node, closed_set_);
-
     //    auto hybrid_astar_time = std::chrono::high_resolution_clock::now();
+    //    std::chrono::duration<double> hastar_core_duration = hybrid_astar_time - start_time;
+    //    LOG_INF("hastar_core took: " << hastar_core_duration.count() << "s_val");
+
+    return finishPath(*final_node);
+  }
 
-    // Smooth path with gradient descent
-    Smoother::smooth_path(path);
+  return {};
+}
 
-    // interpolate path with B-Splines
-    interpolatePath(path, interp_res_);
+/**
+ * Anytime planning to the final pose in the style of ARA*. The first search inflates the heuristic by
+ * ANYTIME_INFLATION_START to find a path fast. Once no cheaper path can be found with the current inflation, it is
+ * lowered by ANYTIME_INFLATION_STEP down to 1 and the open list is reordered by the new costs, the open and closed sets
+ * are kept. Closed nodes are never updated because it would cause steps in the path, so the inconsistent nodes of ARA*
+ * are not reopened and the suboptimality bound of the inflation is not guaranteed. Stops after ANYTIME_TIMEOUT, if
+ * the search with an inflation of 1 is done or if it is cancelled.
+ * @param start_node
+ * @param goal_node
+ * @param on_path called with every cheaper path and the inflation it was found with, these paths are not smoothed.
+ * The returned path is passed last with smoothed set. Must not call the planner
+ * @param options the goal heuristic and the cancel token are used, the cost bound is not
+ * @return the cheapest path, smoothed
+ */
+std::optional<Path> HybridAStar::hybridAStarAnytimePlanning(const NodeHybrid& start_node,
+                                                            const NodeHybrid& goal_node,
+                                                            const PathCallback& on_path,
+                                                            const SearchOptions& options)
+{
+  resetSearch();
+  inflation_ = std::max(params_.anytime_inflation_start, 1.0);
 
-    //    std::chrono::duration<double> hastar_core_duration = hybrid_astar_time - start_time;
-    //    LOG_INF("hastar_core took: " << hastar_core_duration.count() << "s_val");
+  // choose between waypoint types, a given goal heuristic replaces the ones of the environment
+  const NodeDiscGrid* dist_heuristic =
+      options.goal_heuristic != nullptr ? options.goal_heuristic : &astar_.closed_set_guidance_;
+  if (params_.waypoint_type != HEUR_RED and params_.waypoint_type != NONE and options.goal_heuristic == nullptr)
+  {
+    bool for_path = true;
+    astar_.calcDistanceHeuristic(
+        { goal_node.x_index, goal_node.y_index }, { start_node.x_index, start_node.y_index }, for_path);
+    dist_heuristic = &astar_.closed_set_path_;
+  }
+
+  if (!putStartNode(start_node, goal_node, *dist_heuristic))
+  {
+    return {};
+  }
 
+  std::optional<NodeHybrid> best_node;
+  std::vector<NodeHybrid> final_nodes;
+  const auto finish = [&]() -> std::optional<Path> {
+    if (!best_node)
+    {
+      return {};
+    }
+    Path path = finishPath(*best_node);
+    if (on_path)
+    {
+      on_path(path, inflation_, true);
+    }
     return path;
+  };
+
+  // The clock and the cancel token are only checked every few iterations
+  size_t nb_iter_since_check = 0;
+  auto t_1 = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> timeout = std::chrono::milliseconds(params_.anytime_timeout_ms);
+  while (true)
+  {
+    // No cheaper path can be found with the current inflation
+    if (open_queue_.empty() or (best_node and open_queue_.topPriority() >= best_node->cost))
+    {
+      if (open_queue_.empty() or inflation_ <= 1)
+      {
+        return finish();
+      }
+
+      inflation_ =
+          params_.anytime_inflation_step > 0 ? std::max(inflation_ - params_.anytime_inflation_step, 1.0) : 1.0;
+      node_pool_.forEach(NodePool<NodeHybrid>::OPEN, [&](size_t index, const NodeHybrid& node) {
+        open_queue_.put(index, calcCost(node, goal_node, *dist_heuristic));
+      });
+      continue;
+    }
+
+    if (++nb_iter_since_check >= params_.deadline_check_interval)
+    {
+      nb_iter_since_check = 0;
+      std::chrono::duration<double, std::milli> ms_double = std::chrono::high_resolution_clock::now() - t_1;
+      if (ms_double > timeout)
+      {
+        return finish();
+      }
+
+      // Cancelled from another thread
+      if (options.cancel_token != nullptr && options.cancel_token->isCancelled())
+      {
+        return finish();
+      }
+    }
+
+    const size_t curr_open_idx = open_queue_.get();
+    if (!node_pool_.isOpen(curr_open_idx))
+    {
+      continue;
+    }
+
+    // copied, the reference into the pool is invalidated by inserting the neighbors
+    const NodeHybrid current_node = node_pool_.close(curr_open_idx);
+
+    if (check4Expansions(current_node, *dist_heuristic))
+    {
+      final_nodes.clear();
+      tryAnalyticExpansions(current_node, goal_node, final_nodes);
+      bool improved = false;
+      for (const NodeHybrid& final_node : final_nodes)
+      {
+        if (!best_node or final_node.cost < best_node->cost)
+        {
+          best_node = final_node;
+          best_node->set_analytic();
+          improved = true;
+        }
+      }
+
+      // The ancestors of the final node are closed and thereby never replaced, so the path can be built right away.
+      // Smoothing takes longer than the search, so only the returned path is smoothed
+      if (improved and on_path)
+      {
+        Path path = getFinalPath(*best_node, node_pool_);
+        interpolatePath(path, params_.interp_res);
+        on_path(path, inflation_, false);
+      }
+    }
+
+    expandNeighbors(current_node, goal_node, *dist_heuristic);
   }
+}
 
-  return {};
+/**
+ * Builds the path to the final node and smooths and interpolates it
+ * @param final_node
+ * @return
+ */
+Path HybridAStar::finishPath(const NodeHybrid& final_node)
+{
+  Path path = getFinalPath(final_node, node_pool_);
+  path.is_partial = is_partial_;
+
+  // Smooth path with gradient descent
+  smoother_.smooth_path(path);
+
+  // interpolate path with B-Splines
+  interpolatePath(path, params_.interp_res);
+
+  return path;
 }
 
 std::optional<Pose<double>> HybridAStar::getValidClosePose(const Pose<double>& ego_pose, const Pose<double>& goal_pose)
@@ -1680,13 +2071,13 @@ std::optional<Pose<double>> HybridAStar::getValidClosePose(const Pose<double>& e
   bool for_path = false;
   bool get_only_near = true;
   // inversed on purpose because we want to sweep from start to goal
-  AStar::calcDistanceHeuristic(
+  astar_.calcDistanceHeuristic(
       { ego_node.x_index, ego_node.y_index }, { goal_node.x_index, goal_node.y_index }, for_path, get_only_near);
 
   // 2. take closest node
   double min_dist = 1e9;
   NodeDisc closest_node = ego_node.getNodeDisc();
-  for (auto [dist, node] : AStar::nodes_near_goal_)
+  for (auto [dist, node] : astar_.nodes_near_goal_)
   {
     if (dist < min_dist)
     {
@@ -1696,19 +2087,19 @@ std::optional<Pose<double>> HybridAStar::getValidClosePose(const Pose<double>& e
   }
 
   // 3. find collision free pose around it
-  const Pose<double> center_pose = { closest_node.pos.x * grid_tf::star2con_,
-                                     closest_node.pos.y * grid_tf::star2con_,
-                                     goal_node.yaw_list[0] };
+  const Pose<double> center_pose = { closest_node.pos.x * grid_tf_.star2con_,
+                                     closest_node.pos.y * grid_tf_.star2con_,
+                                     goal_node.pose.yaw };
 
   const double dxy_max = 2.0;
   const double dphi_max = util::PI;
 
-  double phi_res = yaw_res_coll_ * util::TO_RAD;
+  double phi_res = params_.yaw_res_coll * util::TO_RAD;
 
   Pose<double> free_goal_pose;
   double min_cost = std::numeric_limits<double>::max();
 
-  const int dxy_max_idx = static_cast<int>(std::floor(dxy_max) / gm_res_);
+  const int dxy_max_idx = static_cast<int>(std::floor(dxy_max) / params_.gm_res);
   const int dphi_max_idx = static_cast<int>(std::floor(dphi_max) / phi_res);
 
   for (int dxi = -dxy_max_idx; dxi < dxy_max_idx; ++dxi)
@@ -1717,15 +2108,15 @@ std::optional<Pose<double>> HybridAStar::getValidClosePose(const Pose<double>& e
     {
       for (int dphii = -dphi_max_idx; dphii < dphi_max_idx; ++dphii)
       {
-        const double x_diff = dxi * gm_res_;
-        const double y_diff = dyi * gm_res_;
+        const double x_diff = dxi * params_.gm_res;
+        const double y_diff = dyi * params_.gm_res;
         const double phi_diff = dphii * phi_res;
 
         // Calculate costs: distance to actual goal
         const double dist2 = x_diff * x_diff + y_diff * y_diff;
 
         const Pose<double> pose = { center_pose.x + x_diff, center_pose.y + y_diff, center_pose.yaw + phi_diff };
-        const double prox_cost = getProxOfCorners(grid_tf::utm2astar(pose));
+        const double prox_cost = getProxOfCorners(grid_tf_.utm2astar(pose));
 
         // naive cost function
         const double cost = dist2 + phi_diff * 0.1 + prox_cost * 5.0;
@@ -1736,13 +2127,13 @@ std::optional<Pose<double>> HybridAStar::getValidClosePose(const Pose<double>& e
         }
 
         // check if inside list of nearest goal
-        const Point<int> index2d = grid_tf::utm2astar(pose.getPoint()).toInt();
-        const size_t index = AStar::calcIndex(index2d.x, index2d.y);
+        const Point<int> index2d = grid_tf_.utm2astar(pose.getPoint()).toInt();
+        const size_t index = astar_.calcIndex(index2d.x, index2d.y);
 
         bool found = false;
-        for (const auto& [dist, node] : AStar::nodes_near_goal_)
+        for (const auto& [dist, node] : astar_.nodes_near_goal_)
         {
-          if (index == AStar::calcIndex(node))
+          if (index == astar_.calcIndex(node))
           {
             found = true;
             break;
@@ -1754,7 +2145,7 @@ std::optional<Pose<double>> HybridAStar::getValidClosePose(const Pose<double>& e
         }
 
         // check against collision
-        if (CollisionChecker::checkPose(pose))
+        if (collision_checker_.checkPose(pose))
         {
           free_goal_pose = pose;
           min_cost = cost;
@@ -1775,7 +2166,7 @@ std::pair<double, double> HybridAStar::getMaxMeanProximityVec(const std::vector<
   for (size_t i = 0; i < nb_elements; i++)
   {
     const double prox =
-        util::getBilinInterp(x_list.at(i) * grid_tf::con2star_, y_list.at(i) * grid_tf::con2star_, AStar::h_prox_arr_);
+        util::getBilinInterp(x_list.at(i) * grid_tf_.con2star_, y_list.at(i) * grid_tf_.con2star_, astar_.h_prox_arr_);
     if (prox > max_proximity)
     {
       max_proximity = prox;
@@ -1794,33 +2185,38 @@ std::pair<double, double> HybridAStar::getMaxMeanProximity(const Path& path)
 
 std::unordered_map<size_t, NodeHybrid> HybridAStar::getClosedSet()
 {
-  return closed_set_;
+  std::unordered_map<size_t, NodeHybrid> closed_set;
+  closed_set.reserve(node_pool_.nbClosed());
+  node_pool_.forEach(NodePool<NodeHybrid>::CLOSED,
+                     [this, &closed_set](size_t index, const NodeHybrid& node) {
+                       NodeHybrid& vis_node = closed_set.emplace(index, node).first->second;
+                       traj_arena_.fillNodeLists(vis_node);
+                     });
+  return closed_set;
 }
 
 std::pair<std::vector<double>, std::vector<double>> HybridAStar::getConnectedClosedNodes()
 {
   // recreate vector if necessary
-  if (!closed_set_.empty() and connected_closed_nodes_.first.empty())
+  if (node_pool_.nbClosed() > 0 and connected_closed_nodes_.first.empty())
   {
     // reconnect all nodes with the last coordinate of their parent
-    connected_closed_nodes_.first.resize(closed_set_.size() * 2);
-    connected_closed_nodes_.second.resize(closed_set_.size() * 2);
+    connected_closed_nodes_.first.resize(node_pool_.nbClosed() * 2);
+    connected_closed_nodes_.second.resize(node_pool_.nbClosed() * 2);
     size_t index = 0;
-    for (auto node_pair : closed_set_)
-    {
-      NodeHybrid node = node_pair.second;
+    node_pool_.forEach(NodePool<NodeHybrid>::CLOSED, [this, &index](size_t /*node_index*/, const NodeHybrid& node) {
       if (node.parent_index != -1)
       {
-        NodeHybrid parent_node = closed_set_.at(node.parent_index);
+        const NodeHybrid& parent_node = node_pool_.at(node.parent_index);
 
         // Add to list for vis
-        connected_closed_nodes_.first.at(2 * index) = parent_node.x_list.back();
-        connected_closed_nodes_.first.at(2 * index + 1) = node.x_list.back();
-        connected_closed_nodes_.second.at(2 * index) = parent_node.y_list.back();
-        connected_closed_nodes_.second.at(2 * index + 1) = node.y_list.back();
+        connected_closed_nodes_.first.at(2 * index) = parent_node.pose.x;
+        connected_closed_nodes_.first.at(2 * index + 1) = node.pose.x;
+        connected_closed_nodes_.second.at(2 * index) = parent_node.pose.y;
+        connected_closed_nodes_.second.at(2 * index + 1) = node.pose.y;
         index++;
       }
-    }
+    });
     return connected_closed_nodes_;
   }
 
@@ -1830,7 +2226,50 @@ std::pair<std::vector<double>, std::vector<double>> HybridAStar::getConnectedClo
 
 std::unordered_map<size_t, NodeHybrid> HybridAStar::getOpenSet()
 {
-  return open_set_;
+  std::unordered_map<size_t, NodeHybrid> open_set;
+  open_set.reserve(node_pool_.nbOpen());
+  node_pool_.forEach(NodePool<NodeHybrid>::OPEN,
+                     [this, &open_set](size_t index, const NodeHybrid& node) {
+                       NodeHybrid& vis_node = open_set.emplace(index, node).first->second;
+                       traj_arena_.fillNodeLists(vis_node);
+                     });
+  return open_set;
+}
+
+/**
+ * Closed set of the last search as flat records, e.g. for the visualization
+ * @return buffer of the planner, views on it keep it alive
+ */
+std::shared_ptr<const std::vector<NodeHybridRecord>> HybridAStar::getClosedNodes()
+{
+  return fillNodeRecords(NodePool<NodeHybrid>::CLOSED, closed_records_);
+}
+
+/**
+ * Open set of the last search as flat records, e.g. for the visualization
+ * @return buffer of the planner, views on it keep it alive
+ */
+std::shared_ptr<const std::vector<NodeHybridRecord>> HybridAStar::getOpenNodes()
+{
+  return fillNodeRecords(NodePool<NodeHybrid>::OPEN, open_records_);
+}
+
+/**
+ * Writes the index, the last pose, the costs and the parent of all nodes with the status into the buffer. Unlike
+ * getClosedSet and getOpenSet, the trajectories of the nodes are not copied
+ * @param status
+ * @param buffer
+ * @return
+ */
+std::shared_ptr<const std::vector<NodeHybridRecord>> HybridAStar::fillNodeRecords(NodePool<NodeHybrid>::STATUS status,
+                                                                                  RecordBuffer<NodeHybridRecord>& buffer)
+{
+  std::vector<NodeHybridRecord>& records = buffer.refill();
+  records.reserve(status == NodePool<NodeHybrid>::CLOSED ? node_pool_.nbClosed() : node_pool_.nbOpen());
+  node_pool_.forEach(status, [&records](size_t index, const NodeHybrid& node) {
+    records.push_back({ index, node.pose.x, node.pose.y, node.pose.yaw, node.cost, node.parent_index });
+  });
+  return buffer.get();
 }
 
 std::tuple<Pose<double>, int, double> HybridAStar::projEgoOnPath(const Pose<double>& pose,
@@ -1977,11 +2416,11 @@ void HybridAStar::interpolatePathSegment(Path& path_segment, const Segment& segm
   //    const double x_diff = path_segment.x_list[i + 1] - path_segment.x_list[i];
   //    const double y_diff = path_segment.y_list[i + 1] - path_segment.y_list[i];
   //    const double dist = sqrt(x_diff * x_diff + y_diff * y_diff);
-  //    LOG_INF("Dist is: " << dist << " != " << interp_res_);
-  //    if (abs(dist - interp_res_) > 0.01)
+  //    LOG_INF("Dist is: " << dist << " != " << params_.interp_res);
+  //    if (abs(dist - params_.interp_res) > 0.01)
   //    {
   //      LOG_ERR("Interp dist is off at idx = " << i << " of " << path_segment.x_list.size() - 1);
-  //      LOG_ERR("Dist is: " << dist << " != " << interp_res_);
+  //      LOG_ERR("Dist is: " << dist << " != " << params_.interp_res);
   //    }
   //  }
 }
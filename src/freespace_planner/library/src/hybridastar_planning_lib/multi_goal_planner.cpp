@@ -0,0 +1,113 @@
+#include "hybridastar_planning_lib/multi_goal_planner.hpp"
+
+MultiGoalPlanner::MultiGoalPlanner(const Vehicle& vehicle,
+                                   grid_tf& transforms,
+                                   CollisionChecker& collision_checker,
+                                   Cartographing& cartographing,
+                                   AStar& astar,
+                                   Smoother& smoother,
+                                   HybridAStar& hybrid_astar)
+  : vehicle_(vehicle)
+  , grid_tf_(transforms)
+  , collision_checker_(collision_checker)
+  , cartographing_(cartographing)
+  , astar_(astar)
+  , smoother_(smoother)
+  , hybrid_astar_(hybrid_astar)
+{
+}
+
+void MultiGoalPlanner::init()
+{
+  // Load config
+  YAML::Node config = YAML::LoadFile(astar_.path2config_);
+  const auto nb_threads = config["MULTI_GOAL_THREADS"].as<size_t>();
+  goal_pool_.resize(nb_threads > 0 ? nb_threads : std::thread::hardware_concurrency());
+  is_initialized_ = true;
+}
+
+/**
+ * Plans from the start to all goals on the environment of the hybrid planner, which must have been initialized and
+ * recalculated before. Every worker calculates the guidance heuristic of its goal itself. If only the best path is
+ * requested, the costs of the best path found so far bound all other searches, which give up as soon as they can not
+ * beat it anymore
+ * @param ego_node
+ * @param start_node
+ * @param goal_nodes
+ * @param to_final_pose
+ * @param do_analytic
+ * @param only_best
+ * @return pairs of the goal index and the path to it, ordered by the path costs
+ */
+std::vector<std::pair<size_t, Path>> MultiGoalPlanner::plan(const NodeHybrid& ego_node,
+                                                            const NodeHybrid& start_node,
+                                                            const std::vector<NodeHybrid>& goal_nodes,
+                                                            bool to_final_pose,
+                                                            bool do_analytic,
+                                                            bool only_best)
+{
+  if (!is_initialized_)
+  {
+    init();
+  }
+
+  // One worker per thread, as the goals are handed out one after another
+  const size_t nb_workers = std::min(goal_nodes.size(), goal_pool_.size());
+  while (workers_.size() < nb_workers)
+  {
+    workers_.push_back(
+        std::make_unique<Worker>(vehicle_, grid_tf_, collision_checker_, cartographing_, astar_, smoother_));
+  }
+  for (size_t worker_idx = 0; worker_idx < nb_workers; ++worker_idx)
+  {
+    workers_[worker_idx]->planner.shareEnvironment(hybrid_astar_);
+  }
+
+  std::vector<std::optional<Path>> paths(goal_nodes.size());
+  std::atomic<size_t> next_goal = 0;
+  std::atomic<double> best_cost = std::numeric_limits<double>::infinity();
+  const Point<int> start_pos = { start_node.x_index, start_node.y_index };
+
+  goal_pool_.parallelFor(nb_workers, [&](size_t worker_idx) {
+    Worker& worker = *workers_[worker_idx];
+    for (size_t goal_idx = next_goal++; goal_idx < goal_nodes.size(); goal_idx = next_goal++)
+    {
+      const NodeHybrid& goal_node = goal_nodes[goal_idx];
+      astar_.calcGoalHeuristic({ goal_node.x_index, goal_node.y_index }, start_pos, worker.heuristic);
+
+      HybridAStar::SearchOptions options;
+      options.goal_heuristic = &worker.heuristic.node_grid;
+      options.cost_bound = only_best ? &best_cost : nullptr;
+      paths[goal_idx] = worker.planner.planPath(ego_node, start_node, goal_node, to_final_pose, do_analytic, options);
+      if (!paths[goal_idx])
+      {
+        continue;
+      }
+
+      // Lower the bound of the other searches
+      double cost = best_cost.load();
+      while (paths[goal_idx]->cost < cost && !best_cost.compare_exchange_weak(cost, paths[goal_idx]->cost))
+      {
+      }
+    }
+  });
+
+  std::vector<std::pair<size_t, Path>> ranked_paths;
+  for (size_t goal_idx = 0; goal_idx < paths.size(); ++goal_idx)
+  {
+    if (paths[goal_idx])
+    {
+      ranked_paths.emplace_back(goal_idx, std::move(*paths[goal_idx]));
+    }
+  }
+  std::stable_sort(ranked_paths.begin(), ranked_paths.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.cost < rhs.second.cost;
+  });
+
+  if (only_best && ranked_paths.size() > 1)
+  {
+    ranked_paths.erase(ranked_paths.begin() + 1, ranked_paths.end());
+  }
+
+  return ranked_paths;
+}
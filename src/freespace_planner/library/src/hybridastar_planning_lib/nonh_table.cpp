@@ -0,0 +1,299 @@
+#include "hybridastar_planning_lib/nonh_table.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util_lib/thread_pool.hpp"
+
+/**
+ * Maps an existing table file if its header matches the expected parameters
+ * @param path
+ * @param key hash of all parameters the table depends on
+ * @param yaw_dim
+ * @param patch_dim
+ * @param value_type
+ * @param layout
+ * @return false if the file is missing, belongs to other parameters or is truncated
+ */
+bool NonhTable::load(const std::string& path,
+                     uint64_t key,
+                     int yaw_dim,
+                     int patch_dim,
+                     ValueType value_type,
+                     Layout layout)
+{
+  release();
+
+  const int file = open(path.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    return false;
+  }
+
+  const int stored_dim = storedDim(patch_dim, layout);
+  const size_t expected_size =
+      sizeof(Header) + static_cast<size_t>(yaw_dim) * stored_dim * stored_dim * valueSize(value_type);
+  struct stat file_stat = {};
+  if (fstat(file, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) != expected_size)
+  {
+    close(file);
+    return false;
+  }
+
+  void* mapping = mmap(nullptr, expected_size, PROT_READ, MAP_SHARED, file, 0);
+  // The mapping stays valid after closing the file
+  close(file);
+  if (mapping == MAP_FAILED)
+  {
+    return false;
+  }
+
+  Header header{};
+  std::memcpy(&header, mapping, sizeof(Header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+      header.value_type != value_type || header.layout != layout || header.yaw_dim != static_cast<uint32_t>(yaw_dim) ||
+      header.patch_dim != static_cast<uint32_t>(patch_dim) || header.key != key)
+  {
+    munmap(mapping, expected_size);
+    return false;
+  }
+
+  // The mapping is released with the last view on it
+  setStorage({ static_cast<const uint8_t*>(mapping) + sizeof(Header),
+               [mapping, expected_size](const uint8_t* /*values*/) { munmap(mapping, expected_size); } },
+             true);
+  setDims(yaw_dim, patch_dim, value_type, layout);
+  return true;
+}
+
+/**
+ * Calculates the table in parallel over the yaw slices, writes it and maps the written file. The file is written
+ * under a temporary name and renamed, so other processes never see a partial table. If the file can not be written,
+ * the table is kept in memory.
+ * @param path
+ * @param key
+ * @param yaw_dim
+ * @param patch_dim
+ * @param value_type
+ * @param layout
+ * @param nb_threads
+ * @param row_generator
+ */
+void NonhTable::generate(const std::string& path,
+                         uint64_t key,
+                         int yaw_dim,
+                         int patch_dim,
+                         ValueType value_type,
+                         Layout layout,
+                         size_t nb_threads,
+                         const RowGenerator& row_generator)
+{
+  release();
+
+  // Only the stored cells are calculated, for the symmetric layout they start at the goal
+  const int stored_dim = storedDim(patch_dim, layout);
+  const int offset = (layout == SYMMETRIC) ? (patch_dim - 1) / 2 : 0;
+  const size_t slice_size = static_cast<size_t>(stored_dim) * stored_dim;
+  std::vector<float> values(yaw_dim * slice_size);
+
+  ThreadPool thread_pool;
+  thread_pool.resize(nb_threads);
+  thread_pool.parallelFor(yaw_dim, [&](size_t yaw_idx) {
+    float* slice = values.data() + yaw_idx * slice_size;
+    for (int y_ind = 0; y_ind < stored_dim; ++y_ind)
+    {
+      row_generator(static_cast<int>(yaw_idx),
+                    y_ind + offset,
+                    offset,
+                    std::span<float>(slice + static_cast<size_t>(y_ind) * stored_dim, stored_dim));
+    }
+  });
+
+  // Convert to the stored type
+  const size_t value_size = valueSize(value_type);
+  auto owned_values = std::make_shared<std::vector<uint8_t>>(values.size() * value_size);
+  if (value_type == FLOAT16)
+  {
+    auto* half_values = reinterpret_cast<uint16_t*>(owned_values->data());
+    for (size_t index = 0; index < values.size(); ++index)
+    {
+      half_values[index] = toHalf(values[index]);
+    }
+  }
+  else
+  {
+    std::memcpy(owned_values->data(), values.data(), owned_values->size());
+  }
+  const std::shared_ptr<const uint8_t> owned_storage(owned_values, owned_values->data());
+  setStorage(owned_storage, false);
+  setDims(yaw_dim, patch_dim, value_type, layout);
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.value_type = value_type;
+  header.layout = layout;
+  header.yaw_dim = yaw_dim;
+  header.patch_dim = patch_dim;
+  header.key = key;
+
+  const std::string temp_path = path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream output_file(temp_path, std::ios::binary);
+    output_file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    output_file.write(reinterpret_cast<const char*>(owned_values->data()),
+                      static_cast<std::streamsize>(owned_values->size()));
+    if (!output_file)
+    {
+      std::cout << "Could not write the non-holonomic heuristic to " << path << ", keeping it in memory" << std::endl;
+      std::filesystem::remove(temp_path);
+      return;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  if (error || !load(path, key, yaw_dim, patch_dim, value_type, layout))
+  {
+    std::filesystem::remove(temp_path, error);
+    setStorage(owned_storage, false);
+    setDims(yaw_dim, patch_dim, value_type, layout);
+  }
+}
+
+/**
+ * Number of stored cells per axis
+ * @param patch_dim
+ * @param layout
+ * @return
+ */
+int NonhTable::storedDim(int patch_dim, Layout layout)
+{
+  return (layout == SYMMETRIC) ? (patch_dim + 1) / 2 : patch_dim;
+}
+
+/**
+ * FNV-1a hash over the parameters
+ * @param params
+ * @return
+ */
+uint64_t NonhTable::hashKey(std::initializer_list<double> params)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const double param : params)
+  {
+    uint8_t bytes[sizeof(double)];
+    std::memcpy(bytes, &param, sizeof(double));
+    for (const uint8_t byte : bytes)
+    {
+      hash = (hash ^ byte) * 1099511628211ULL;
+    }
+  }
+  return hash;
+}
+
+/**
+ * Converts to IEEE 754 half precision, rounding to nearest. Values beyond the range become infinity
+ * @param value
+ * @return
+ */
+uint16_t NonhTable::toHalf(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(float));
+  const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  const int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+  uint32_t mantissa = bits & 0x7FFFFF;
+
+  // Subnormal half or zero
+  if (exponent <= 0)
+  {
+    if (exponent < -10)
+    {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const int shift = 14 - exponent;
+    const uint32_t rounding = (mantissa >> (shift - 1)) & 1;
+    return static_cast<uint16_t>(sign | ((mantissa >> shift) + rounding));
+  }
+  if (exponent >= 31)
+  {
+    return static_cast<uint16_t>(sign | 0x7C00);
+  }
+
+  // A rounding carry into the exponent is the correct result
+  const uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+  const uint32_t rounding = (mantissa >> 12) & 1;
+  return static_cast<uint16_t>(sign | (half + rounding));
+}
+
+/**
+ * Converts from IEEE 754 half precision
+ * @param value
+ * @return
+ */
+float NonhTable::fromHalf(uint16_t value)
+{
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1F;
+  const uint32_t mantissa = value & 0x3FF;
+
+  uint32_t bits;
+  if (exponent == 0)
+  {
+    // Zero or subnormal, exact in single precision
+    const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0 ? -magnitude : magnitude;
+  }
+  if (exponent == 31)
+  {
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  }
+  else
+  {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+  float result;
+  std::memcpy(&result, &bits, sizeof(float));
+  return result;
+}
+
+void NonhTable::setStorage(std::shared_ptr<const uint8_t> storage, bool is_mapped)
+{
+  storage_ = std::move(storage);
+  values_ = storage_.get();
+  is_mapped_ = is_mapped;
+}
+
+/**
+ * Drops the reference on the values, views on them keep them alive
+ */
+void NonhTable::release()
+{
+  storage_.reset();
+  values_ = nullptr;
+  is_mapped_ = false;
+}
+
+void NonhTable::setDims(int yaw_dim, int patch_dim, ValueType value_type, Layout layout)
+{
+  value_type_ = value_type;
+  layout_ = layout;
+  yaw_dim_ = yaw_dim;
+  stored_dim_ = storedDim(patch_dim, layout);
+  center_ = (patch_dim - 1) / 2;
+}
+
+size_t NonhTable::valueSize(ValueType value_type)
+{
+  return value_type == FLOAT16 ? sizeof(uint16_t) : sizeof(float);
+}
@@ -0,0 +1,21 @@
+#include "hybridastar_planning_lib/planner_context.hpp"
+
+PlannerContext::PlannerContext()
+  : collision_checker_(vehicle_, grid_tf_)
+  , cartographing_(collision_checker_, grid_tf_)
+  , astar_(collision_checker_, grid_tf_)
+  , smoother_(astar_, collision_checker_, vehicle_, grid_tf_)
+  , hybrid_astar_(vehicle_, grid_tf_, collision_checker_, cartographing_, astar_, smoother_)
+  , multi_goal_planner_(vehicle_, grid_tf_, collision_checker_, cartographing_, astar_, smoother_, hybrid_astar_)
+{
+}
+
+/**
+ * Context of the python bindings, which keep using the modules as if they were static. It is created on first use
+ * @return
+ */
+PlannerContext& PlannerContext::defaultContext()
+{
+  static PlannerContext context;
+  return context;
+}
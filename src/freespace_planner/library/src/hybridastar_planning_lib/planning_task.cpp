@@ -0,0 +1,100 @@
+#include "hybridastar_planning_lib/planning_task.hpp"
+
+/**
+ * Starts the search, it is run on the worker thread and destroyed there
+ * @param context
+ * @param search
+ */
+PlanningTask::PlanningTask(PlannerContext& context, Search search)
+  : result_(promise_.get_future())
+  , thread_([this, &context, search = std::move(search)]() {
+    try
+    {
+      const std::lock_guard<std::mutex> search_lock(context.search_mutex_);
+      const std::shared_lock<std::shared_mutex> lock(context.mutex_);
+      HybridAStar::SearchOptions options;
+      options.cancel_token = &token_;
+      promise_.set_value(search(context.hybrid_astar_, options));
+    }
+    catch (...)
+    {
+      promise_.set_exception(std::current_exception());
+    }
+  })
+{
+}
+
+/**
+ * Starts HybridAStar::planPath. The nodes are copied, so the caller does not have to keep them alive
+ * @param context
+ * @param ego_node
+ * @param start_node
+ * @param goal_node
+ * @param to_final_pose
+ * @param do_analytic
+ */
+PlanningTask::PlanningTask(PlannerContext& context,
+                           const NodeHybrid& ego_node,
+                           const NodeHybrid& start_node,
+                           const NodeHybrid& goal_node,
+                           bool to_final_pose,
+                           bool do_analytic)
+  : PlanningTask(context,
+                 [ego_node, start_node, goal_node, to_final_pose, do_analytic](
+                     HybridAStar& planner, const HybridAStar::SearchOptions& options) {
+                   return planner.planPath(ego_node, start_node, goal_node, to_final_pose, do_analytic, options);
+                 })
+{
+}
+
+/**
+ * Nobody can get the result anymore, so a running search is cancelled
+ */
+PlanningTask::~PlanningTask()
+{
+  cancel();
+  thread_.join();
+}
+
+/**
+ * @return true if the search is done, cancelled or failed
+ */
+bool PlanningTask::poll() const
+{
+  return result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+/**
+ * Blocks until the search is done
+ * @param timeout_s waits forever if not given
+ * @return true if the search is done, false if the timeout passed first
+ */
+bool PlanningTask::wait(std::optional<double> timeout_s) const
+{
+  if (!timeout_s)
+  {
+    result_.wait();
+    return true;
+  }
+  return result_.wait_for(std::chrono::duration<double>(*timeout_s)) == std::future_status::ready;
+}
+
+/**
+ * Stops the search, it notices the cancellation within DEADLINE_CHECK_INTERVAL iterations. planPath then returns the
+ * partial path to the most promising node if PARTIAL_PATH is set, otherwise no path. The anytime planning returns
+ * the cheapest path found so far
+ */
+void PlanningTask::cancel()
+{
+  token_.cancel();
+}
+
+/**
+ * Blocks until the search is done and rethrows its exception if it failed
+ * @return the path, partial if the search was cancelled and PARTIAL_PATH is set, nothing if no path was found or the
+ * search was cancelled without PARTIAL_PATH
+ */
+std::optional<Path> PlanningTask::get() const
+{
+  return result_.get();
+}
@@ -0,0 +1,204 @@
+#include "hybridastar_planning_lib/primitive_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+void PrimitiveCache::build(const std::vector<double>& steering_inputs,
+                           const std::vector<int>& direction_inputs,
+                           double arc_l,
+                           double motion_res_min,
+                           double motion_res_max,
+                           size_t nb_res_buckets,
+                           double yaw_bin_res_rad)
+{
+  segments_.clear();
+  dx_.clear();
+  dy_.clear();
+  dyaw_.clear();
+  res_buckets_.clear();
+  footprints_built_ = false;
+
+  if (nb_res_buckets == 0)
+  {
+    return;
+  }
+
+  nb_controls_ = steering_inputs.size() * direction_inputs.size();
+  yaw_bin_res_ = yaw_bin_res_rad;
+  nb_yaw_bins_ = static_cast<size_t>(std::round(2 * util::PI / yaw_bin_res_));
+
+  // Constant resolution does not need more than one bucket
+  if (motion_res_max <= motion_res_min)
+  {
+    nb_res_buckets = 1;
+  }
+  for (size_t bucket = 0; bucket < nb_res_buckets; ++bucket)
+  {
+    const double ratio = nb_res_buckets > 1 ? static_cast<double>(bucket) / static_cast<double>(nb_res_buckets - 1) : 0;
+    res_buckets_.push_back(motion_res_min + ratio * (motion_res_max - motion_res_min));
+  }
+
+  directions_.resize(nb_controls_);
+  segments_.resize(nb_yaw_bins_ * nb_controls_ * res_buckets_.size());
+
+  for (size_t yaw_bin = 0; yaw_bin < nb_yaw_bins_; ++yaw_bin)
+  {
+    const Pose<double> start = { 0, 0, util::constrainAngleMinPIPlusPi(yaw_bin * yaw_bin_res_) };
+
+    for (size_t steer_idx = 0; steer_idx < steering_inputs.size(); ++steer_idx)
+    {
+      for (size_t dir_idx = 0; dir_idx < direction_inputs.size(); ++dir_idx)
+      {
+        const size_t control_idx = steer_idx * direction_inputs.size() + dir_idx;
+        directions_[control_idx] = direction_inputs[dir_idx];
+
+        for (size_t res_bucket = 0; res_bucket < res_buckets_.size(); ++res_bucket)
+        {
+          const MotionPrimitive primitive = vehicle_.move_car_some_steps(
+              start, arc_l, res_buckets_[res_bucket], direction_inputs[dir_idx], steering_inputs[steer_idx]);
+
+          TrajSegment& segment = segments_[getIndex(yaw_bin, control_idx, res_bucket)];
+          segment.offset = static_cast<uint32_t>(dx_.size());
+          segment.length = static_cast<uint32_t>(primitive.x_list_.size());
+          for (size_t i = 0; i < primitive.x_list_.size(); ++i)
+          {
+            dx_.push_back(primitive.x_list_[i]);
+            dy_.push_back(primitive.y_list_[i]);
+            dyaw_.push_back(util::constrainAngleMinPIPlusPi(primitive.yaw_list_[i] - start.yaw));
+          }
+        }
+      }
+    }
+  }
+}
+
+size_t PrimitiveCache::getResBucket(double motion_res) const
+{
+  if (res_buckets_.size() == 1)
+  {
+    return 0;
+  }
+
+  const double res_min = res_buckets_.front();
+  const double bucket_width = (res_buckets_.back() - res_min) / static_cast<double>(res_buckets_.size() - 1);
+  const double bucket = std::round((motion_res - res_min) / bucket_width);
+  return static_cast<size_t>(std::clamp(bucket, 0.0, static_cast<double>(res_buckets_.size() - 1)));
+}
+
+MotionPrimitive PrimitiveCache::apply(const Pose<double>& pose, size_t control_idx, size_t res_bucket) const
+{
+  const size_t yaw_bin = getYawBin(pose.yaw);
+  const TrajSegment& segment = segments_[getIndex(yaw_bin, control_idx, res_bucket)];
+
+  // The cached primitive is rotated to the bin yaw, only the residual is left
+  const double residual_yaw = pose.yaw - static_cast<double>(yaw_bin) * yaw_bin_res_;
+  const double cos_yaw = cos(residual_yaw);
+  const double sin_yaw = sin(residual_yaw);
+
+  MotionPrimitive motion_primitive(segment.length);
+  for (size_t i = segment.offset, end = segment.offset + segment.length; i < end; ++i)
+  {
+    motion_primitive.x_list_.push_back(pose.x + cos_yaw * dx_[i] - sin_yaw * dy_[i]);
+    motion_primitive.y_list_.push_back(pose.y + sin_yaw * dx_[i] + cos_yaw * dy_[i]);
+    motion_primitive.yaw_list_.push_back(util::constrainAngleMinPIPlusPi(pose.yaw + dyaw_[i]));
+  }
+  motion_primitive.dir_list_.resize(segment.length, directions_[control_idx]);
+
+  return motion_primitive;
+}
+
+void PrimitiveCache::setFootprintPhases(size_t nb_phases)
+{
+  if (nb_phases != nb_phases_)
+  {
+    nb_phases_ = nb_phases;
+    footprints_built_ = false;
+  }
+}
+
+void PrimitiveCache::updateFootprints()
+{
+  if (!footprintsEnabled() || (footprints_built_ && footprints_version_ == collision_checker_.getDisksVersion()))
+  {
+    return;
+  }
+
+  const size_t nb_variants = nb_phases_ * nb_phases_;
+  footprint_segments_.resize(segments_.size() * nb_variants);
+  footprint_cells_.clear();
+
+  const auto cell_less = [](const Point<int>& lhs, const Point<int>& rhs) {
+    return std::tie(lhs.y, lhs.x) < std::tie(rhs.y, rhs.x);
+  };
+  const auto is_same = [](const Point<int>& lhs, const Point<int>& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; };
+  std::vector<Point<int>> cells;
+
+  for (size_t yaw_bin = 0; yaw_bin < nb_yaw_bins_; ++yaw_bin)
+  {
+    // Both limits of the yaw bin
+    const std::array<double, 2> yaws = { static_cast<double>(yaw_bin) * yaw_bin_res_,
+                                         static_cast<double>(yaw_bin + 1) * yaw_bin_res_ };
+
+    for (size_t control_idx = 0; control_idx < nb_controls_; ++control_idx)
+    {
+      for (size_t res_bucket = 0; res_bucket < res_buckets_.size(); ++res_bucket)
+      {
+        for (size_t phase_y = 0; phase_y < nb_phases_; ++phase_y)
+        {
+          for (size_t phase_x = 0; phase_x < nb_phases_; ++phase_x)
+          {
+            // Union of the swept cells of the starts at the corners of the phase with both yaw limits
+            cells.clear();
+            for (const double yaw : yaws)
+            {
+              for (size_t corner = 0; corner < 4; ++corner)
+              {
+                const Pose<double> start = {
+                  (FOOTPRINT_ORIGIN + static_cast<double>(phase_x + corner % 2) / static_cast<double>(nb_phases_)) *
+                      grid_tf_.gm2con_,
+                  (FOOTPRINT_ORIGIN + static_cast<double>(phase_y + corner / 2) / static_cast<double>(nb_phases_)) *
+                      grid_tf_.gm2con_,
+                  util::constrainAngleMinPIPlusPi(yaw)
+                };
+                const MotionPrimitive primitive = apply(start, control_idx, res_bucket);
+                const std::vector<Point<int>> swept_cells =
+                    collision_checker_.getSweptCells(primitive.x_list_, primitive.y_list_, primitive.yaw_list_);
+                cells.insert(cells.end(), swept_cells.begin(), swept_cells.end());
+              }
+            }
+            std::sort(cells.begin(), cells.end(), cell_less);
+            cells.erase(std::unique(cells.begin(), cells.end(), is_same), cells.end());
+
+            const size_t index =
+                getIndex(yaw_bin, control_idx, res_bucket) * nb_variants + phase_y * nb_phases_ + phase_x;
+            TrajSegment& segment = footprint_segments_[index];
+            segment.offset = static_cast<uint32_t>(footprint_cells_.size());
+            for (const Point<int>& cell : cells)
+            {
+              footprint_cells_.emplace_back(cell.x - FOOTPRINT_ORIGIN, cell.y - FOOTPRINT_ORIGIN);
+            }
+            segment.length = static_cast<uint32_t>(footprint_cells_.size()) - segment.offset;
+          }
+        }
+      }
+    }
+  }
+
+  footprints_version_ = collision_checker_.getDisksVersion();
+  footprints_built_ = true;
+}
+
+bool PrimitiveCache::checkFootprint(const Pose<double>& pose, size_t control_idx, size_t res_bucket) const
+{
+  const double cell_x = pose.x * grid_tf_.con2gm_;
+  const double cell_y = pose.y * grid_tf_.con2gm_;
+  const Point<int> origin(static_cast<int>(cell_x), static_cast<int>(cell_y));
+
+  const size_t index = getIndex(getYawBin(pose.yaw), control_idx, res_bucket) * nb_phases_ * nb_phases_ +
+                       getPhase(cell_y) * nb_phases_ + getPhase(cell_x);
+  const TrajSegment& segment = footprint_segments_[index];
+
+  return collision_checker_.checkSweptCells(
+      origin, { footprint_cells_.data() + segment.offset, footprint_cells_.data() + segment.offset + segment.length });
+}
@@ -7,7 +7,7 @@
 void Smoother::init()
 {
   // Load config
-  YAML::Node config = YAML::LoadFile(AStar::path2config_);
+  YAML::Node config = YAML::LoadFile(astar_.path2config_);
 
   max_iter_ = config["MAX_ITER"].as<unsigned int>();
   wCurvature_ = config["W_CURVATURE"].as<double>();
@@ -15,7 +15,7 @@ void Smoother::init()
   wSmoothness_ = config["W_SMOOTHNESS"].as<double>();
   alpha_ = config["ALPHA_OPT"].as<double>();
   is_initialized_ = true;
-  kappaMax_ = Vehicle::max_curvature_;
+  kappaMax_ = vehicle_.max_curvature_;
 }
 
 /**
@@ -135,7 +135,7 @@ void Smoother::smooth_path(Path& path)
   do
   {
     Smoother::optimize_gd(path, collision_indices);
-    coll_idx = CollisionChecker::getPathCollisionIndex(path.x_list, path.y_list, path.yaw_list);
+    coll_idx = collision_checker_.getPathCollisionIndex(path.x_list, path.y_list, path.yaw_list);
     if (coll_idx != -1)
     {
       //      LOG_INF("Resetting coordinate, found collision at " << coll_idx);
@@ -168,13 +168,13 @@ Point<double> Smoother::obsTerm(const Point<double>& xi0, const Point<double>& x
   //  LOG_INF("xi0 " << xi0);
   Point<double> diff = xip - xi0;
   double yaw = std::atan2(diff.getY(), diff.getX());
-  double rot_geo_center_x = Vehicle::geo_center_ * cos(yaw);
-  double rot_geo_center_y = Vehicle::geo_center_ * sin(yaw);
+  double rot_geo_center_x = vehicle_.geo_center_ * cos(yaw);
+  double rot_geo_center_y = vehicle_.geo_center_ * sin(yaw);
   // Do bilinear interpolation of gradients
-  double x_val = (xi0.getX() + rot_geo_center_x) * grid_tf::con2star_;
-  double y_val = (xi0.getY() + rot_geo_center_y) * grid_tf::con2star_;
-  double x_grad = util::getBilinInterp(x_val, y_val, AStar::obs_x_grad_);
-  double y_grad = util::getBilinInterp(x_val, y_val, AStar::obs_y_grad_);
+  double x_val = (xi0.getX() + rot_geo_center_x) * grid_tf_.con2star_;
+  double y_val = (xi0.getY() + rot_geo_center_y) * grid_tf_.con2star_;
+  double x_grad = util::getBilinInterp(x_val, y_val, astar_.obs_x_grad_);
+  double y_grad = util::getBilinInterp(x_val, y_val, astar_.obs_y_grad_);
   Point<double> grad(x_grad, y_grad);
 
   // If there is no gradient
@@ -3,12 +3,170 @@
 //
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 
 #include "hybridastar_planning_lib/hybrid_a_star_lib.hpp"
+#include "hybridastar_planning_lib/planner_context.hpp"
+#include "hybridastar_planning_lib/planning_task.hpp"
 
 namespace py = pybind11;
 
+/**
+ * A planning task may hold a lock for a whole search, so the GIL is released while waiting for it if the call holds
+ * the GIL
+ * @param lock
+ */
+template <typename Lock>
+void lockWithoutGil(Lock& lock)
+{
+  if (lock.try_lock())
+  {
+    return;
+  }
+  if (PyGILState_Check() != 0)
+  {
+    const py::gil_scoped_release release;
+    lock.lock();
+  }
+  else
+  {
+    lock.lock();
+  }
+}
+
+/**
+ * Locks the default planner context exclusively for one call, it waits for a running planning task
+ * @return
+ */
+std::unique_lock<std::shared_mutex> lockDefaultContext()
+{
+  std::unique_lock<std::shared_mutex> lock(PlannerContext::defaultContext().mutex_, std::defer_lock);
+  lockWithoutGil(lock);
+  return lock;
+}
+
+/**
+ * Locks the default planner context for a call that only reads or updates the map patches. A planning task holds the
+ * context shared and its search does not read these patches, so the call does not wait for it
+ * @return
+ */
+std::pair<std::shared_lock<std::shared_mutex>, std::unique_lock<std::mutex>> lockDefaultIngestion()
+{
+  PlannerContext& context = PlannerContext::defaultContext();
+  std::shared_lock<std::shared_mutex> context_lock(context.mutex_, std::defer_lock);
+  std::unique_lock<std::mutex> ingest_lock(context.ingest_mutex_, std::defer_lock);
+  lockWithoutGil(context_lock);
+  lockWithoutGil(ingest_lock);
+  return { std::move(context_lock), std::move(ingest_lock) };
+}
+
+/**
+ * Python uses the modules through their classes, so the methods are bound as static functions that forward to the
+ * module of the default planner context. The calls are serialized by the lock of the context, the map updates pass
+ * lockDefaultIngestion
+ * @param module
+ * @param method
+ * @return
+ */
+template <auto lock_context = &lockDefaultContext, typename Module, typename Ret, typename... Args>
+auto onDefault(Module PlannerContext::*module, Ret (Module::*method)(Args...))
+{
+  return [module, method](Args... args) -> Ret {
+    const auto lock = lock_context();
+    return ((PlannerContext::defaultContext().*module).*method)(std::forward<Args>(args)...);
+  };
+}
+
+template <auto lock_context = &lockDefaultContext, typename Module, typename Ret, typename... Args>
+auto onDefault(Module PlannerContext::*module, Ret (Module::*method)(Args...) const)
+{
+  return [module, method](Args... args) -> Ret {
+    const auto lock = lock_context();
+    return ((PlannerContext::defaultContext().*module).*method)(std::forward<Args>(args)...);
+  };
+}
+
+/**
+ * Getter of a static property that forwards to the member of the module of the default planner context. Reading does
+ * not wait for a planning task
+ * @param module
+ * @param member
+ * @return
+ */
+template <typename Module, typename T>
+auto getDefault(Module PlannerContext::*module, T Module::*member)
+{
+  return [module, member](const py::object& /*cls*/) -> const T& {
+    const auto lock = lockDefaultIngestion();
+    return (PlannerContext::defaultContext().*module).*member;
+  };
+}
+
+template <typename Module, typename T>
+auto setDefault(Module PlannerContext::*module, T Module::*member)
+{
+  return [module, member](const py::object& /*cls*/, const T& value) {
+    const auto lock = lockDefaultContext();
+    (PlannerContext::defaultContext().*module).*member = value;
+  };
+}
+
+/**
+ * Static function that returns the records of the module of the default planner context as read only structured numpy
+ * array, the array shares the ownership of the records
+ * @param module
+ * @param method
+ * @return
+ */
+template <typename Module, typename Record, typename... Args>
+auto viewOnDefault(Module PlannerContext::*module, std::shared_ptr<const std::vector<Record>> (Module::*method)(Args...))
+{
+  return [module, method](Args... args) {
+    const auto lock = lockDefaultContext();
+    auto records = ((PlannerContext::defaultContext().*module).*method)(std::forward<Args>(args)...);
+    const auto nb_records = static_cast<py::ssize_t>(records->size());
+    return numpyView<Record>({ nb_records }, std::move(records));
+  };
+}
+
+/**
+ * Method of a grid that returns a read only view on it, the view shares the ownership of the memory of the grid. The
+ * search does not replace the memory of the grids, so this does not wait for a planning task
+ * @return
+ */
+template <typename Grid>
+auto gridView()
+{
+  return [](const Grid& self) {
+    const auto lock = lockDefaultIngestion();
+    return self.getNumpyArr();
+  };
+}
+
+/**
+ * Deletes a planning task without the GIL, the task joins its thread and the search may wait for the GIL to call
+ * back into python
+ */
+struct PlanningTaskDeleter
+{
+  void operator()(PlanningTask* task) const
+  {
+    if (PyGILState_Check() != 0)
+    {
+      const py::gil_scoped_release release;
+      delete task;
+    }
+    else
+    {
+      delete task;
+    }
+  }
+};
+
+using PlanningTaskPtr = std::unique_ptr<PlanningTask, PlanningTaskDeleter>;
+
 PYBIND11_MAKE_OPAQUE(Path)
 PYBIND11_MAKE_OPAQUE(NodeHybrid)
 PYBIND11_MAKE_OPAQUE(NodeDisc)
@@ -20,25 +178,39 @@ PYBIND11_MAKE_OPAQUE(std::unordered_map<size_t, NodeDisc>)
 // The method module_::def() generates binding code that exposes the add() function to Python.
 PYBIND11_MODULE(_hybridastar_planning_lib_api, m)
 {
+  // Modules of the default planner context
+  constexpr auto vehicle = &PlannerContext::vehicle_;
+  constexpr auto transforms = &PlannerContext::grid_tf_;
+  constexpr auto collision_checker = &PlannerContext::collision_checker_;
+  constexpr auto cartographing = &PlannerContext::cartographing_;
+  constexpr auto astar = &PlannerContext::astar_;
+  constexpr auto smoother = &PlannerContext::smoother_;
+  constexpr auto hybrid_astar = &PlannerContext::hybrid_astar_;
+  constexpr auto multi_goal_planner = &PlannerContext::multi_goal_planner_;
+
+  PYBIND11_NUMPY_DTYPE(NodeHybridRecord, index, x, y, yaw, cost, parent);
+  PYBIND11_NUMPY_DTYPE(NodeDiscRecord, index, x, y, cost, parent);
+
   py::class_<Vec3DFlat<int>>(m, "Vec3dFlatInt")
       .def("getVal", &Vec3DFlat<int>::getVal, "returns value of vector")
-      .def("getDims", &Vec3DFlat<int>::getDims, "returns dims of vector");
+      .def("getDims", &Vec3DFlat<int>::getDims, "returns dims of vector")
+      .def("getNumpyArr", gridView<Vec3DFlat<int>>(), "Read only view on the grid");
 
   py::class_<Vec2DFlat<int>>(m, "Vec2DFlatInt")
       .def("getDims", &Vec2DFlat<int>::getDims, "returns dims of vector")
-      .def("getNumpyArr", &Vec2DFlat<int>::getNumpyArr, "getNumpyArr");
+      .def("getNumpyArr", gridView<Vec2DFlat<int>>(), "Read only view on the grid");
 
   py::class_<Vec2DFlat<double>>(m, "Vec2DFlatDouble")
       .def("getDims", &Vec2DFlat<double>::getDims, "returns dims of vector")
-      .def("getNumpyArr", &Vec2DFlat<double>::getNumpyArr, "getNumpyArr");
+      .def("getNumpyArr", gridView<Vec2DFlat<double>>(), "Read only view on the grid");
 
   py::class_<Vec2DFlat<uint8_t>>(m, "Vec2DFlatUint8")
       .def("getDims", &Vec2DFlat<uint8_t>::getDims, "returns dims of vector")
-      .def("getNumpyArr", &Vec2DFlat<uint8_t>::getNumpyArr, "getNumpyArr");
+      .def("getNumpyArr", gridView<Vec2DFlat<uint8_t>>(), "Read only view on the grid");
 
   py::class_<Vec2DFlat<int8_t>>(m, "Vec2DFlatInt8")
       .def("getDims", &Vec2DFlat<int8_t>::getDims, "returns dims of vector")
-      .def("getNumpyArr", &Vec2DFlat<int8_t>::getNumpyArr, "getNumpyArr");
+      .def("getNumpyArr", gridView<Vec2DFlat<int8_t>>(), "Read only view on the grid");
 
   py::class_<Pose<double>>(m, "PoseDouble")
       .def(py::init<double, double, double>())
@@ -172,61 +344,199 @@ PYBIND11_MODULE(_hybridastar_planning_lib_api, m)
            [](const std::unordered_map<size_t, NodeDisc>& val) { return py::make_iterator(val.begin(), val.end()); });
 
   py::class_<CollisionChecker>(m, "CollisionChecker")
-      .def_readwrite_static("disk_r_c_", &CollisionChecker::disk_r_c_, "disk_r_c_")
-      .def("initialize", &CollisionChecker::initialize, "Initializes arrays to the sizes in config")
-      .def("calculateDisks", &CollisionChecker::calculateDisks, "calculateDisks")
-      .def("insertMinipatches", &CollisionChecker::insertMinipatches, "insertMinipatches")
-      .def("passLocalMap",
-           py::overload_cast<const py::array_t<uint8_t>&, const Point<int>&, int>(&CollisionChecker::passLocalMap),
-           "Pass local map")
-      .def("passLocalMap",
-           py::overload_cast<const Vec2DFlat<uint8_t>&, const Point<int>&, int>(&CollisionChecker::passLocalMap),
-           "passLocalMap")
-      .def_readonly_static("patch_arr_", &CollisionChecker::patch_arr_)
-      .def_readonly_static("patch_safety_arr_", &CollisionChecker::patch_safety_arr_)
-      .def("returnDiskPositions", &CollisionChecker::returnDiskPositions, "returnDiskPositions")
-      .def("checkGrid", &CollisionChecker::checkGrid, "Check for collision in grid")
-      .def("checkGridVariant", &CollisionChecker::checkGrid, "Check for collision in grid")
-      .def("checkPose", &CollisionChecker::checkPose, "Check for collision of cont. pose in grid")
-      .def("checkPoseVariant", &CollisionChecker::checkPoseVariant, "Check for collision of cont. pose in grid")
-      .def("getPathCollisionIndex",
-           &CollisionChecker::getPathCollisionIndex,
-           "Check for collision of a path in grid, return index of collision")
-      .def("processSafetyPatch", &CollisionChecker::processSafetyPatch, "dilate patch for collision checks");
+      .def_property_static("disk_r_c_",
+                           getDefault(collision_checker, &CollisionChecker::disk_r_c_),
+                           setDefault(collision_checker, &CollisionChecker::disk_r_c_))
+      .def_static("initialize",
+                  onDefault(collision_checker, &CollisionChecker::initialize),
+                  "Initializes arrays to the sizes in config")
+      .def_static("calculateDisks", onDefault(collision_checker, &CollisionChecker::calculateDisks), "calculateDisks")
+      .def_static("insertMinipatches",
+                  onDefault<&lockDefaultIngestion>(collision_checker, &CollisionChecker::insertMinipatches),
+                  "insertMinipatches")
+      .def_static("passLocalMap",
+                  onDefault<&lockDefaultIngestion>(
+                      collision_checker,
+                      py::overload_cast<const py::array_t<uint8_t>&, const Point<int>&, int>(
+                          &CollisionChecker::passLocalMap)),
+                  "Pass local map")
+      .def_static("passLocalMap",
+                  onDefault<&lockDefaultIngestion>(
+                      collision_checker,
+                      py::overload_cast<const Vec2DFlat<uint8_t>&, const Point<int>&, int>(
+                          &CollisionChecker::passLocalMap)),
+                  "passLocalMap")
+      .def_property_readonly_static("patch_arr_", getDefault(collision_checker, &CollisionChecker::patch_arr_))
+      .def_property_readonly_static("patch_safety_arr_",
+                                    getDefault(collision_checker, &CollisionChecker::patch_safety_arr_))
+      .def_static("returnDiskPositions",
+                  onDefault(collision_checker, &CollisionChecker::returnDiskPositions),
+                  "returnDiskPositions")
+      .def_static("checkGrid",
+                  onDefault(collision_checker, &CollisionChecker::checkGrid),
+                  "Check for collision in grid")
+      .def_static("checkGridVariant",
+                  onDefault(collision_checker, &CollisionChecker::checkGrid),
+                  "Check for collision in grid")
+      .def_static("checkPose",
+                  onDefault(collision_checker, &CollisionChecker::checkPose),
+                  "Check for collision of cont. pose in grid")
+      .def_static("checkPoseVariant",
+                  onDefault(collision_checker, &CollisionChecker::checkPoseVariant),
+                  "Check for collision of cont. pose in grid")
+      .def_static("getPathCollisionIndex",
+                  onDefault(collision_checker, &CollisionChecker::getPathCollisionIndex),
+                  "Check for collision of a path in grid, return index of collision")
+      .def_static("processSafetyPatch",
+                  onDefault(collision_checker, &CollisionChecker::processSafetyPatch),
+                  py::call_guard<py::gil_scoped_release>(),
+                  "dilate patch for collision checks");
+
+  py::class_<ExpansionScheduler::Stats>(m, "ExpansionStats")
+      .def_readonly("nb_checks", &ExpansionScheduler::Stats::nb_checks)
+      .def_readonly("nb_attempts", &ExpansionScheduler::Stats::nb_attempts)
+      .def_readonly("nb_rs_found", &ExpansionScheduler::Stats::nb_rs_found)
+      .def_readonly("nb_ra_found", &ExpansionScheduler::Stats::nb_ra_found)
+      .def_readonly("attempt_time_ms", &ExpansionScheduler::Stats::attempt_time_ms);
 
   py::class_<HybridAStar>(m, "HybridAStar")
-      .def_readwrite_static("switch_cost_", &HybridAStar::switch_cost_)
-      .def_readwrite_static("steer_cost_", &HybridAStar::steer_cost_)
-      .def_readwrite_static("steer_change_cost_", &HybridAStar::steer_change_cost_)
-      .def_readwrite_static("h_dist_cost_", &HybridAStar::h_dist_cost_)
-      .def_readwrite_static("back_cost_", &HybridAStar::back_cost_)
-      .def_readwrite_static("h_prox_cost_", &HybridAStar::h_prox_cost_)
-
-      .def_readwrite_static("astar_dim_", &AStar::astar_dim_)
-      .def_readwrite_static("lane_graph_", &HybridAStar::lane_graph_)
-
-      .def("setSim", &HybridAStar::setSim)
-      .def("initialize", &HybridAStar::initialize)
-      .def("reinit", &HybridAStar::reinit)
-      .def("hybridAStarPlanning",
-           &HybridAStar::hybridAStarPlanning,
-           "Hybrid A Star algorithm with heuristic creation and path extraction")
-      .def("getClosedSet", &HybridAStar::getClosedSet, "Get closed set (visited nodes")
-      .def("getConnectedClosedNodes", &HybridAStar::getConnectedClosedNodes, "Get closed set (visited nodes")
-      .def("getOpenSet", &HybridAStar::getOpenSet, "Get open set (to be visited nodes")
-      .def("getNonhnoobsVal", &HybridAStar::getNonhnoobsVal, "getNonhnoobsVal")
-      .def("recalculateEnv", &HybridAStar::recalculateEnv, "recalculateEnv")
-      .def("createNode", &HybridAStar::createNode, "createNode")
-      .def("getDistance2GlobalGoal", &HybridAStar::getDistance2GlobalGoal, "getDistance2GlobalGoal")
-      .def("getMaxMeanProximityVec", &HybridAStar::getMaxMeanProximityVec, "getMaxMeanProximityVec")
-      .def("projEgoOnPath", &HybridAStar::projEgoOnPath, "projEgoOnPath")
-      .def("getValidClosePose", &HybridAStar::getValidClosePose, "getValidClosePose")
-      .def("resetLaneGraph", &HybridAStar::resetLaneGraph, "resetLaneGraph")
-      .def("updateLaneGraph", &HybridAStar::updateLaneGraph, "updateLaneGraph")
-      .def("smoothLaneGraph", &HybridAStar::smoothLaneGraph, "smoothLaneGraph")
-      .def("interpolateLaneGraph", &HybridAStar::interpolateLaneGraph, "smoothLaneGraph");
-
-  py::class_<Smoother>(m, "Smoother").def("smooth_path", &Smoother::smooth_path);
+      .def_property_static("switch_cost_",
+                           getDefault(hybrid_astar, &HybridAStar::switch_cost_),
+                           setDefault(hybrid_astar, &HybridAStar::switch_cost_))
+      .def_property_static("steer_cost_",
+                           getDefault(hybrid_astar, &HybridAStar::steer_cost_),
+                           setDefault(hybrid_astar, &HybridAStar::steer_cost_))
+      .def_property_static("steer_change_cost_",
+                           getDefault(hybrid_astar, &HybridAStar::steer_change_cost_),
+                           setDefault(hybrid_astar, &HybridAStar::steer_change_cost_))
+      .def_property_static("h_dist_cost_",
+                           getDefault(hybrid_astar, &HybridAStar::h_dist_cost_),
+                           setDefault(hybrid_astar, &HybridAStar::h_dist_cost_))
+      .def_property_static("back_cost_",
+                           getDefault(hybrid_astar, &HybridAStar::back_cost_),
+                           setDefault(hybrid_astar, &HybridAStar::back_cost_))
+      .def_property_static("h_prox_cost_",
+                           getDefault(hybrid_astar, &HybridAStar::h_prox_cost_),
+                           setDefault(hybrid_astar, &HybridAStar::h_prox_cost_))
+
+      .def_property_static("astar_dim_", getDefault(astar, &AStar::astar_dim_), setDefault(astar, &AStar::astar_dim_))
+      .def_property_static("lane_graph_",
+                           getDefault(hybrid_astar, &HybridAStar::lane_graph_),
+                           setDefault(hybrid_astar, &HybridAStar::lane_graph_))
+
+      .def_static("setSim", onDefault(hybrid_astar, &HybridAStar::setSim))
+      .def_static("initialize", onDefault(hybrid_astar, &HybridAStar::initialize))
+      .def_static("reinit", onDefault(hybrid_astar, &HybridAStar::reinit))
+      .def_static("hybridAStarPlanning",
+                  onDefault(hybrid_astar, &HybridAStar::hybridAStarPlanning),
+                  py::call_guard<py::gil_scoped_release>(),
+                  "Hybrid A Star algorithm with heuristic creation and path extraction")
+      .def_static(
+          "planAsync",
+          [](const NodeHybrid& ego_node,
+             const NodeHybrid& start_node,
+             const NodeHybrid& goal_node,
+             bool to_final_pose,
+             bool do_analytic) {
+            return PlanningTaskPtr(new PlanningTask(
+                PlannerContext::defaultContext(), ego_node, start_node, goal_node, to_final_pose, do_analytic));
+          },
+          "hybridAStarPlanning on a worker thread, returns a PlanningTask. The task holds the planner while it plans, "
+          "calls that change the planner and other tasks wait until it is done or cancelled. Property reads, grid "
+          "views and the map updates (Cartographing.cartograph, Cartographing.passLocalMap, Cartographing.getMap, "
+          "CollisionChecker.passLocalMap, CollisionChecker.insertMinipatches) do not wait, the search does not read "
+          "the map until processSafetyPatch")
+      .def_static(
+          "hybridAStarAnytimePlanning",
+          [](const NodeHybrid& start_node, const NodeHybrid& goal_node, const HybridAStar::PathCallback& on_path) {
+            const auto lock = lockDefaultContext();
+            return PlannerContext::defaultContext().hybrid_astar_.hybridAStarAnytimePlanning(
+                start_node, goal_node, on_path, {});
+          },
+          py::arg("start_node"),
+          py::arg("goal_node"),
+          py::arg("on_path") = py::none(),
+          py::call_guard<py::gil_scoped_release>(),
+          "Anytime planning to the final pose, returns the cheapest path smoothed. Calls on_path(path, inflation, "
+          "smoothed) with every cheaper path, these are not smoothed (smoothed=False). The returned path is passed "
+          "last with smoothed=True, so the last call equals the result. The callback must not call the planner")
+      .def_static(
+          "planAnytimeAsync",
+          [](const NodeHybrid& start_node, const NodeHybrid& goal_node, const HybridAStar::PathCallback& on_path) {
+            return PlanningTaskPtr(new PlanningTask(
+                PlannerContext::defaultContext(),
+                [start_node, goal_node, on_path](HybridAStar& planner, const HybridAStar::SearchOptions& options) {
+                  return planner.hybridAStarAnytimePlanning(start_node, goal_node, on_path, options);
+                }));
+          },
+          py::arg("start_node"),
+          py::arg("goal_node"),
+          py::arg("on_path") = py::none(),
+          "hybridAStarAnytimePlanning on a worker thread, returns a PlanningTask. on_path is called on the worker "
+          "thread. Locks the planner like planAsync. Cancelling returns the cheapest path found so far")
+      .def_static("getClosedSet", onDefault(hybrid_astar, &HybridAStar::getClosedSet), "Get closed set (visited nodes")
+      .def_static("getConnectedClosedNodes",
+                  onDefault(hybrid_astar, &HybridAStar::getConnectedClosedNodes),
+                  "Get closed set (visited nodes")
+      .def_static("getOpenSet", onDefault(hybrid_astar, &HybridAStar::getOpenSet), "Get open set (to be visited nodes")
+      .def_static("getClosedNodes",
+                  viewOnDefault(hybrid_astar, &HybridAStar::getClosedNodes),
+                  "Closed set as structured array (index, x, y, yaw, cost, parent)")
+      .def_static("getOpenNodes",
+                  viewOnDefault(hybrid_astar, &HybridAStar::getOpenNodes),
+                  "Open set as structured array (index, x, y, yaw, cost, parent)")
+      .def_static("getExpansionStats",
+                  onDefault(hybrid_astar, &HybridAStar::getExpansionStats),
+                  py::return_value_policy::copy,
+                  "Analytic expansion statistics of the last search")
+      .def_static("getNonhnoobsVal", onDefault(hybrid_astar, &HybridAStar::getNonhnoobsVal), "getNonhnoobsVal")
+      .def_static("getNonhnoobsTable",
+                  onDefault(hybrid_astar, &HybridAStar::getNonhnoobsTable),
+                  "Copy of the non-holonomic heuristic table")
+      .def_static("recalculateEnv",
+                  onDefault(hybrid_astar, &HybridAStar::recalculateEnv),
+                  py::call_guard<py::gil_scoped_release>(),
+                  "recalculateEnv")
+      .def_static("createNode", onDefault(hybrid_astar, &HybridAStar::createNode), "createNode")
+      .def_static("getDistance2GlobalGoal",
+                  onDefault(hybrid_astar, &HybridAStar::getDistance2GlobalGoal),
+                  "getDistance2GlobalGoal")
+      .def_static("getMaxMeanProximityVec",
+                  onDefault(hybrid_astar, &HybridAStar::getMaxMeanProximityVec),
+                  "getMaxMeanProximityVec")
+      .def_static("projEgoOnPath", &HybridAStar::projEgoOnPath, "projEgoOnPath")
+      .def_static("getValidClosePose", onDefault(hybrid_astar, &HybridAStar::getValidClosePose), "getValidClosePose")
+      .def_static("resetLaneGraph", onDefault(hybrid_astar, &HybridAStar::resetLaneGraph), "resetLaneGraph")
+      .def_static("updateLaneGraph", onDefault(hybrid_astar, &HybridAStar::updateLaneGraph), "updateLaneGraph")
+      .def_static("smoothLaneGraph", &HybridAStar::smoothLaneGraph, "smoothLaneGraph")
+      .def_static("interpolateLaneGraph",
+                  onDefault(hybrid_astar, &HybridAStar::interpolateLaneGraph),
+                  "smoothLaneGraph");
+
+  py::class_<Smoother>(m, "Smoother").def_static("smooth_path", onDefault(smoother, &Smoother::smooth_path));
+
+  py::class_<MultiGoalPlanner>(m, "MultiGoalPlanner")
+      .def_static("plan",
+                  onDefault(multi_goal_planner, &MultiGoalPlanner::plan),
+                  py::call_guard<py::gil_scoped_release>(),
+                  "Plans to all goals in parallel, returns (goal index, path) pairs ordered by the path costs");
+
+  py::class_<PlanningTask, PlanningTaskPtr>(m, "PlanningTask")
+      .def("poll", &PlanningTask::poll, "True if the search is done")
+      .def("wait",
+           &PlanningTask::wait,
+           py::arg("timeout") = py::none(),
+           py::call_guard<py::gil_scoped_release>(),
+           "Waits for the search, returns False if the timeout in seconds passed first")
+      .def("cancel",
+           &PlanningTask::cancel,
+           "Stops the search within DEADLINE_CHECK_INTERVAL iterations. planAsync then returns the partial path if "
+           "PARTIAL_PATH is set, otherwise no path, planAnytimeAsync returns the cheapest path found so far")
+      .def("get",
+           &PlanningTask::get,
+           py::call_guard<py::gil_scoped_release>(),
+           "Waits for the search and returns its path. A cancelled planAsync returns the partial path (is_partial) if "
+           "PARTIAL_PATH is set and None otherwise, None if no path was found");
 
   py::class_<NodeHybrid>(m, "NodeHybrid")
       .def(py::init<int,
@@ -258,21 +568,29 @@ PYBIND11_MODULE(_hybridastar_planning_lib_api, m)
       .def_readwrite("dist", &NodeHybrid::dist);
 
   py::class_<Vehicle>(m, "Vehicle")
-      .def("initialize", &Vehicle::initialize, "(re)Initializes the car params")
-      .def("setPose", &Vehicle::setPose, "setPose")
-      .def("getVehicleVertices", &Vehicle::getVehicleVertices, "getVehicleVertices");
+      .def_static("initialize", onDefault(vehicle, &Vehicle::initialize), "(re)Initializes the car params")
+      .def_static("setPose", onDefault(vehicle, &Vehicle::setPose), "setPose")
+      .def_static("getVehicleVertices", onDefault(vehicle, &Vehicle::getVehicleVertices), "getVehicleVertices");
 
   py::class_<Cartographing>(m, "Cartographing")
-      .def("resetPatch", &Cartographing::resetPatch, "resetPatch")
-      .def("cartograph",
-           py::overload_cast<const py::array_t<uint8_t>&, const Point<int>&, int>(&Cartographing::cartograph),
-           "cartograph")
-      .def("cartograph",
-           py::overload_cast<const Vec2DFlat<uint8_t>&, const Point<int>&, int>(&Cartographing::cartograph),
-           "cartograph")
-      .def("passLocalMap", &Cartographing::passLocalMap, "passLocalMap")
-      .def("getMap", &Cartographing::getMap, "getMap")
-      .def("loadPrevPatch", &Cartographing::loadPrevPatch, "loadPrevPatch");
+      .def_static("resetPatch", onDefault(cartographing, &Cartographing::resetPatch), "resetPatch")
+      .def_static("cartograph",
+                  onDefault<&lockDefaultIngestion>(
+                      cartographing,
+                      py::overload_cast<const py::array_t<uint8_t>&, const Point<int>&, int>(&Cartographing::cartograph)),
+                  "cartograph")
+      .def_static("cartograph",
+                  onDefault<&lockDefaultIngestion>(
+                      cartographing,
+                      py::overload_cast<const Vec2DFlat<uint8_t>&, const Point<int>&, int>(&Cartographing::cartograph)),
+                  "cartograph")
+      .def_static("passLocalMap",
+                  onDefault<&lockDefaultIngestion>(cartographing, &Cartographing::passLocalMap),
+                  "passLocalMap")
+      .def_static("getMap",
+                  onDefault<&lockDefaultIngestion>(cartographing, &Cartographing::getMap),
+                  "Read only view on the map")
+      .def_static("loadPrevPatch", onDefault(cartographing, &Cartographing::loadPrevPatch), "loadPrevPatch");
 
   py::class_<Path>(m, "Path")
       .def_readwrite("x_list", &Path::x_list)
@@ -282,7 +600,8 @@ PYBIND11_MODULE(_hybridastar_planning_lib_api, m)
       .def_readwrite("cost", &Path::cost)
       .def_readwrite("idx_analytic", &Path::idx_analytic)
       .def_readwrite("types", &Path::types)
-      .def_readwrite("is_emergency", &Path::is_emergency);
+      .def_readwrite("is_emergency", &Path::is_emergency)
+      .def_readwrite("is_partial", &Path::is_partial);
 
   py::enum_<PATH_TYPE>(m, "PATH_TYPE", py::arithmetic())
       .value("HASTAR", PATH_TYPE::HASTAR)
@@ -301,66 +620,117 @@ PYBIND11_MODULE(_hybridastar_planning_lib_api, m)
       .def_readwrite("is_unknown_", &NodeDisc::is_unknown_);
 
   py::class_<AStar>(m, "AStar")
-      .def_readwrite_static("alpha_", &AStar::alpha_)
-      .def_readwrite_static("do_max_", &AStar::do_max_)
-      .def_readwrite_static("do_min_", &AStar::do_min_)
-      .def_readwrite_static("astar_prox_cost_", &AStar::astar_prox_cost_)
-      .def_readwrite_static("astar_movement_cost_", &AStar::astar_movement_cost_)
-      .def_readwrite_static("astar_lane_movement_cost_", &AStar::astar_lane_movement_cost_)
-
-      .def_readonly_static("movement_cost_map_", &AStar::movement_cost_map_)
-      .def_readonly_static("astar_grid_", &AStar::astar_grid_)
-      .def_readonly_static("h_prox_arr_", &AStar::h_prox_arr_)
-      .def_readonly_static("motion_res_map_", &AStar::motion_res_map_)
-      .def("getAstarPath", &AStar::getAstarPath, "Extracts the discrete a star path")
-      .def("getObsGradX", &AStar::getObsGradX, "getObsGradX")
-      .def("getObsGradY", &AStar::getObsGradY, "getObsGradY")
-      .def("getDistanceHeuristic", &AStar::getDistanceHeuristic, "getDistanceHeuristic");
+      .def_property_static("alpha_", getDefault(astar, &AStar::alpha_), setDefault(astar, &AStar::alpha_))
+      .def_property_static("do_max_", getDefault(astar, &AStar::do_max_), setDefault(astar, &AStar::do_max_))
+      .def_property_static("do_min_", getDefault(astar, &AStar::do_min_), setDefault(astar, &AStar::do_min_))
+      .def_property_static("astar_prox_cost_",
+                           getDefault(astar, &AStar::astar_prox_cost_),
+                           setDefault(astar, &AStar::astar_prox_cost_))
+      .def_property_static("astar_movement_cost_",
+                           getDefault(astar, &AStar::astar_movement_cost_),
+                           setDefault(astar, &AStar::astar_movement_cost_))
+      .def_property_static("astar_lane_movement_cost_",
+                           getDefault(astar, &AStar::astar_lane_movement_cost_),
+                           setDefault(astar, &AStar::astar_lane_movement_cost_))
+
+      .def_property_readonly_static("movement_cost_map_", getDefault(astar, &AStar::movement_cost_map_))
+      .def_property_readonly_static("astar_grid_", getDefault(astar, &AStar::astar_grid_))
+      .def_property_readonly_static("h_prox_arr_", getDefault(astar, &AStar::h_prox_arr_))
+      .def_property_readonly_static("motion_res_map_", getDefault(astar, &AStar::motion_res_map_))
+      .def_static("getAstarPath", onDefault(astar, &AStar::getAstarPath), "Extracts the discrete a star path")
+      .def_static("getObsGradX", onDefault(astar, &AStar::getObsGradX), "Read only view on the x gradient")
+      .def_static("getObsGradY", onDefault(astar, &AStar::getObsGradY), "Read only view on the y gradient")
+      .def_static("getDistanceHeuristic", onDefault(astar, &AStar::getDistanceHeuristic), "getDistanceHeuristic")
+      .def_static("getDistanceHeuristicNodes",
+                  viewOnDefault(astar, &AStar::getDistanceHeuristicNodes),
+                  "Distance heuristic as structured array (index, x, y, cost, parent)");
 
   auto util = m.def_submodule("UtilCpp");
 
-  util.def("utm2grid", py::overload_cast<const Point<double>&>(&grid_tf::utm2grid<Point<double>>), "utm2grid");
-  util.def("utm2grid", py::overload_cast<const Pose<double>&>(&grid_tf::utm2grid<Pose<double>>), "utm2grid");
-  util.def(
-      "utm2grid", py::overload_cast<const pair_of_vec<double>&>(&grid_tf::utm2grid<pair_of_vec<double>>), "utm2grid");
-
-  util.def("utm2grid_round", py::overload_cast<const Pose<double>&>(&grid_tf::utm2grid_round), "utm2grid_round");
-  util.def("utm2grid_round", py::overload_cast<const Point<double>&>(&grid_tf::utm2grid_round), "utm2grid_round");
-  util.def("utm2grid_round", py::overload_cast<double>(&grid_tf::utm2grid_round), "utm2grid_round");
-
-  util.def("grid2utm", py::overload_cast<const Point<double>&>(&grid_tf::grid2utm<Point<double>>), "grid2utm");
-  util.def("grid2utm", py::overload_cast<const Pose<double>&>(&grid_tf::grid2utm<Pose<double>>), "grid2utm");
+  util.def("utm2grid",
+           onDefault(transforms,
+                     py::overload_cast<const Point<double>&>(&grid_tf::utm2grid<Point<double>>, py::const_)),
+           "utm2grid");
+  util.def("utm2grid",
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::utm2grid<Pose<double>>, py::const_)),
+           "utm2grid");
+  util.def("utm2grid",
+           onDefault(transforms,
+                     py::overload_cast<const pair_of_vec<double>&>(&grid_tf::utm2grid<pair_of_vec<double>>,
+                                                                   py::const_)),
+           "utm2grid");
+
+  util.def("utm2grid_round",
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::utm2grid_round, py::const_)),
+           "utm2grid_round");
+  util.def("utm2grid_round",
+           onDefault(transforms, py::overload_cast<const Point<double>&>(&grid_tf::utm2grid_round, py::const_)),
+           "utm2grid_round");
+  util.def("utm2grid_round",
+           onDefault(transforms, py::overload_cast<double>(&grid_tf::utm2grid_round, py::const_)),
+           "utm2grid_round");
+
+  util.def("grid2utm",
+           onDefault(transforms,
+                     py::overload_cast<const Point<double>&>(&grid_tf::grid2utm<Point<double>>, py::const_)),
+           "grid2utm");
+  util.def("grid2utm",
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::grid2utm<Pose<double>>, py::const_)),
+           "grid2utm");
 
-  util.def("astar2utm", py::overload_cast<const Point<double>&>(&grid_tf::astar2utm<Point<double>>), "astar2utm");
-  util.def("astar2utm", py::overload_cast<const Pose<double>&>(&grid_tf::astar2utm<Pose<double>>), "astar2utm");
   util.def("astar2utm",
-           py::overload_cast<const pair_of_vec<double>&>(&grid_tf::astar2utm<pair_of_vec<double>>),
+           onDefault(transforms,
+                     py::overload_cast<const Point<double>&>(&grid_tf::astar2utm<Point<double>>, py::const_)),
+           "astar2utm");
+  util.def("astar2utm",
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::astar2utm<Pose<double>>, py::const_)),
+           "astar2utm");
+  util.def("astar2utm",
+           onDefault(transforms,
+                     py::overload_cast<const pair_of_vec<double>&>(&grid_tf::astar2utm<pair_of_vec<double>>,
+                                                                   py::const_)),
            "astar2utm");
 
-  util.def("utm2patch_utm", py::overload_cast<const Point<double>&>(&grid_tf::utm2patch_utm), "utm2patch_utm");
-  util.def("utm2patch_utm", py::overload_cast<const Pose<double>&>(&grid_tf::utm2patch_utm), "utm2patch_utm");
   util.def("utm2patch_utm",
-           py::overload_cast<const std::vector<double>&, const std::vector<double>&>(&grid_tf::utm2patch_utm),
+           onDefault(transforms, py::overload_cast<const Point<double>&>(&grid_tf::utm2patch_utm, py::const_)),
+           "utm2patch_utm");
+  util.def("utm2patch_utm",
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::utm2patch_utm, py::const_)),
+           "utm2patch_utm");
+  util.def("utm2patch_utm",
+           onDefault(transforms,
+                     py::overload_cast<const std::vector<double>&, const std::vector<double>&>(&grid_tf::utm2patch_utm,
+                                                                                               py::const_)),
            "utm2patch_utm");
 
-  util.def("patch_utm2utm", py::overload_cast<const Point<double>&>(&grid_tf::patch_utm2utm), "patch_utm2utm");
-  util.def("patch_utm2utm", py::overload_cast<const Pose<double>&>(&grid_tf::patch_utm2utm), "patch_utm2utm");
   util.def("patch_utm2utm",
-           py::overload_cast<const std::vector<double>&, const std::vector<double>&>(&grid_tf::patch_utm2utm),
+           onDefault(transforms, py::overload_cast<const Point<double>&>(&grid_tf::patch_utm2utm, py::const_)),
+           "patch_utm2utm");
+  util.def("patch_utm2utm",
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::patch_utm2utm, py::const_)),
+           "patch_utm2utm");
+  util.def("patch_utm2utm",
+           onDefault(transforms,
+                     py::overload_cast<const std::vector<double>&, const std::vector<double>&>(&grid_tf::patch_utm2utm,
+                                                                                               py::const_)),
+           "patch_utm2utm");
+  util.def("patch_utm2utm",
+           onDefault(transforms, py::overload_cast<const Path&>(&grid_tf::patch_utm2utm, py::const_)),
            "patch_utm2utm");
-  util.def("patch_utm2utm", py::overload_cast<const Path&>(&grid_tf::patch_utm2utm), "patch_utm2utm");
 
   util.def("patch_utm2global_gm",
-           py::overload_cast<const Point<double>&>(&grid_tf::patch_utm2global_gm),
+           onDefault(transforms, py::overload_cast<const Point<double>&>(&grid_tf::patch_utm2global_gm, py::const_)),
            "patch_utm2global_gm");
   util.def("patch_utm2global_gm",
-           py::overload_cast<const Pose<double>&>(&grid_tf::patch_utm2global_gm),
+           onDefault(transforms, py::overload_cast<const Pose<double>&>(&grid_tf::patch_utm2global_gm, py::const_)),
            "patch_utm2global_gm");
   util.def("patch_utm2global_gm",
-           py::overload_cast<const std::vector<double>&, const std::vector<double>&>(&grid_tf::patch_utm2global_gm),
+           onDefault(transforms,
+                     py::overload_cast<const std::vector<double>&, const std::vector<double>&>(
+                         &grid_tf::patch_utm2global_gm, py::const_)),
            "patch_utm2global_gm");
 
-  util.def("utm2global_gm", &grid_tf::utm2global_gm, "utm2global_gm");
+  util.def("utm2global_gm", onDefault(transforms, &grid_tf::utm2global_gm), "utm2global_gm");
 
   util.def("getPathLength", &util::getPathLength);
 }
@@ -0,0 +1,137 @@
+#include "util_lib/distance_transform.hpp"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * Computes the feature transform of all cells
+ * @param is_site x_dim x y_dim mask, row major, non zero cells are sites
+ * @param x_dim
+ * @param y_dim
+ * @param dist_sqr squared distance to the nearest site, infinity without sites
+ * @param nearest flat index of the nearest site, NO_SITE without sites
+ */
+void DistanceTransform::execute(const std::vector<uint8_t>& is_site,
+                                int x_dim,
+                                int y_dim,
+                                std::vector<double>& dist_sqr,
+                                std::vector<int>& nearest)
+{
+  const size_t nb_cells = static_cast<size_t>(x_dim) * y_dim;
+  dist_sqr.resize(nb_cells);
+  nearest.resize(nb_cells);
+  column_site_.resize(nb_cells);
+  row_cost_.resize(x_dim);
+  row_site_.resize(x_dim);
+  envelope_pos_.resize(x_dim);
+  envelope_bounds_.resize(x_dim + 1);
+
+  transformColumns(is_site, x_dim, y_dim);
+
+  for (int y_ind = 0; y_ind < y_dim; ++y_ind)
+  {
+    transformRow(y_ind, x_dim, dist_sqr, nearest);
+  }
+}
+
+/**
+ * Row index of the nearest site within the same column, forward and backward scan
+ * @param is_site
+ * @param x_dim
+ * @param y_dim
+ */
+void DistanceTransform::transformColumns(const std::vector<uint8_t>& is_site, int x_dim, int y_dim)
+{
+  for (int x_ind = 0; x_ind < x_dim; ++x_ind)
+  {
+    int last_site = NO_SITE;
+    for (int y_ind = 0; y_ind < y_dim; ++y_ind)
+    {
+      const size_t index = static_cast<size_t>(y_ind) * x_dim + x_ind;
+      if (is_site[index] != 0)
+      {
+        last_site = y_ind;
+      }
+      column_site_[index] = last_site;
+    }
+
+    last_site = NO_SITE;
+    for (int y_ind = y_dim - 1; y_ind >= 0; --y_ind)
+    {
+      const size_t index = static_cast<size_t>(y_ind) * x_dim + x_ind;
+      if (is_site[index] != 0)
+      {
+        last_site = y_ind;
+      }
+      const int prev_site = column_site_[index];
+      if (last_site != NO_SITE && (prev_site == NO_SITE || last_site - y_ind < y_ind - prev_site))
+      {
+        column_site_[index] = last_site;
+      }
+    }
+  }
+}
+
+/**
+ * Lower envelope of the parabolas rooted at the column results of a row
+ * @param y_ind
+ * @param x_dim
+ * @param dist_sqr
+ * @param nearest
+ */
+void DistanceTransform::transformRow(int y_ind, int x_dim, std::vector<double>& dist_sqr, std::vector<int>& nearest)
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const size_t row_offset = static_cast<size_t>(y_ind) * x_dim;
+
+  // Build the envelope only from columns containing a site
+  int nb_parabolas = 0;
+  for (int x_ind = 0; x_ind < x_dim; ++x_ind)
+  {
+    const int site_y = column_site_[row_offset + x_ind];
+    if (site_y == NO_SITE)
+    {
+      continue;
+    }
+    row_site_[x_ind] = site_y;
+    row_cost_[x_ind] = static_cast<double>((y_ind - site_y) * (y_ind - site_y));
+
+    const double root_val = row_cost_[x_ind] + x_ind * x_ind;
+    double intersect = -inf;
+    while (nb_parabolas > 0)
+    {
+      const int prev_x = envelope_pos_[nb_parabolas - 1];
+      intersect = (root_val - (row_cost_[prev_x] + prev_x * prev_x)) / (2.0 * (x_ind - prev_x));
+      if (intersect > envelope_bounds_[nb_parabolas - 1])
+      {
+        break;
+      }
+      nb_parabolas--;
+      intersect = -inf;
+    }
+    envelope_pos_[nb_parabolas] = x_ind;
+    envelope_bounds_[nb_parabolas] = intersect;
+    nb_parabolas++;
+  }
+
+  if (nb_parabolas == 0)
+  {
+    std::fill(dist_sqr.begin() + row_offset, dist_sqr.begin() + row_offset + x_dim, inf);
+    std::fill(nearest.begin() + row_offset, nearest.begin() + row_offset + x_dim, NO_SITE);
+    return;
+  }
+  envelope_bounds_[nb_parabolas] = inf;
+
+  // Read the envelope
+  int parabola = 0;
+  for (int x_ind = 0; x_ind < x_dim; ++x_ind)
+  {
+    while (envelope_bounds_[parabola + 1] < x_ind)
+    {
+      parabola++;
+    }
+    const int site_x = envelope_pos_[parabola];
+    dist_sqr[row_offset + x_ind] = (x_ind - site_x) * (x_ind - site_x) + row_cost_[site_x];
+    nearest[row_offset + x_ind] = row_site_[site_x] * x_dim + site_x;
+  }
+}
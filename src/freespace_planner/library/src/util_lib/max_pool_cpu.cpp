@@ -0,0 +1,74 @@
+#include "util_lib/max_pool_cpu.hpp"
+
+#include <algorithm>
+#include <limits>
+
+void PoolingCpu::init(int pooling_dim, size_t nb_threads)
+{
+  pooling_dim_ = pooling_dim;
+  thread_pool_.resize(nb_threads);
+  row_max_.resize(thread_pool_.size());
+}
+
+void PoolingCpu::execute(const uint8_t* image_pointer, uint8_t* result, int in_dim, int out_dim)
+{
+  const size_t nb_stripes = std::min(thread_pool_.size(), static_cast<size_t>(std::max(out_dim, 1)));
+  if (nb_stripes <= 1)
+  {
+    poolRows(image_pointer, result, in_dim, out_dim, 0, out_dim, row_max_.front());
+    return;
+  }
+
+  // One stripe of output rows per thread, every stripe has its own row buffer
+  thread_pool_.parallelFor(nb_stripes, [&](size_t stripe) {
+    const int row_begin = static_cast<int>(stripe * out_dim / nb_stripes);
+    const int row_end = static_cast<int>((stripe + 1) * out_dim / nb_stripes);
+    poolRows(image_pointer, result, in_dim, out_dim, row_begin, row_end, row_max_[stripe]);
+  });
+}
+
+void PoolingCpu::poolRows(const uint8_t* image_pointer,
+                          uint8_t* result,
+                          int in_dim,
+                          int out_dim,
+                          int row_begin,
+                          int row_end,
+                          std::vector<int8_t>& row_max) const
+{
+  const int window = pooling_dim_;
+  const int width = std::min(out_dim * window, in_dim);
+  row_max.resize(width);
+
+  for (int out_y = row_begin; out_y < row_end; ++out_y)
+  {
+    const int in_y_begin = out_y * window;
+    const int in_y_end = std::min(in_y_begin + window, in_dim);
+
+    // Elementwise maximum over the rows of the window
+    const auto* first_row = reinterpret_cast<const int8_t*>(image_pointer + static_cast<size_t>(in_y_begin) * in_dim);
+    std::copy(first_row, first_row + width, row_max.begin());
+    for (int in_y = in_y_begin + 1; in_y < in_y_end; ++in_y)
+    {
+      const auto* row = reinterpret_cast<const int8_t*>(image_pointer + static_cast<size_t>(in_y) * in_dim);
+      int8_t* max_ptr = row_max.data();
+      for (int x = 0; x < width; ++x)
+      {
+        max_ptr[x] = std::max(max_ptr[x], row[x]);
+      }
+    }
+
+    // Maximum over the columns of each window
+    uint8_t* out_row = result + static_cast<size_t>(out_y) * out_dim;
+    for (int out_x = 0; out_x < out_dim; ++out_x)
+    {
+      const int in_x_begin = std::min(out_x * window, width);
+      const int in_x_end = std::min(in_x_begin + window, width);
+      int8_t maximum = std::numeric_limits<int8_t>::min();
+      for (int in_x = in_x_begin; in_x < in_x_end; ++in_x)
+      {
+        maximum = std::max(maximum, row_max[in_x]);
+      }
+      out_row[out_x] = static_cast<uint8_t>(maximum);
+    }
+  }
+}
@@ -0,0 +1,127 @@
+#include "util_lib/thread_pool.hpp"
+
+ThreadPool::~ThreadPool()
+{
+  stop();
+}
+
+void ThreadPool::resize(size_t nb_threads)
+{
+  const size_t nb_workers = nb_threads > 1 ? nb_threads - 1 : 0;
+  if (nb_workers == workers_.size())
+  {
+    return;
+  }
+
+  stop();
+
+  // The workers must not miss a job which is started before they are scheduled for the first time
+  stop_ = false;
+  const uint64_t generation = generation_;
+  workers_.reserve(nb_workers);
+  for (size_t i = 0; i < nb_workers; ++i)
+  {
+    workers_.emplace_back(&ThreadPool::workerLoop, this, generation);
+  }
+}
+
+void ThreadPool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    generation_++;
+  }
+  start_cv_.notify_all();
+
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void ThreadPool::parallelFor(size_t nb_tasks, const std::function<void(size_t)>& func)
+{
+  // Not worth waking up anybody
+  if (workers_.empty() || nb_tasks < 2)
+  {
+    for (size_t task_idx = 0; task_idx < nb_tasks; ++task_idx)
+    {
+      func(task_idx);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &func;
+    nb_tasks_ = nb_tasks;
+    next_task_ = 0;
+    nb_busy_ = workers_.size();
+    exception_ = nullptr;
+    generation_++;
+  }
+  start_cv_.notify_all();
+
+  runTasks();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return nb_busy_ == 0; });
+  task_ = nullptr;
+
+  if (exception_)
+  {
+    std::rethrow_exception(exception_);
+  }
+}
+
+void ThreadPool::runTasks()
+{
+  size_t task_idx;
+  while ((task_idx = next_task_.fetch_add(1)) < nb_tasks_)
+  {
+    try
+    {
+      (*task_)(task_idx);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_)
+      {
+        exception_ = std::current_exception();
+      }
+    }
+  }
+}
+
+void ThreadPool::workerLoop(uint64_t last_generation)
+{
+  while (true)
+  {
+    // spin shortly, the next expansion usually follows immediately
+    for (int spin = 0; spin < NB_SPINS && generation_ == last_generation; ++spin)
+    {
+      std::this_thread::yield();
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [this, last_generation] { return generation_ != last_generation; });
+      last_generation = generation_;
+      if (stop_)
+      {
+        return;
+      }
+    }
+
+    runTasks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      nb_busy_--;
+    }
+    done_cv_.notify_one();
+  }
+}